@@ -14,20 +14,73 @@ long file_size(const char* filename);
 int file_copy(const char* src, const char* dest);
 int file_delete(const char* filename);
 
+// Memory-mapped files
+typedef struct {
+    const void* data;
+    size_t size;
+} file_mapping;
+
+int file_map_readonly(const char* filename, file_mapping* map);
+void file_unmap(file_mapping* map);
+
 // Text file operations
 int file_read_text(const char* filename, char* buffer, size_t buffer_size);
 int file_write_text(const char* filename, const char* content);
 int file_append_text(const char* filename, const char* content);
 
+// Buffered writers: close flushes, only io_writer_sync reaches the disk
+#define IO_WRITER_DEFAULT_BUFFER_SIZE (64 * 1024)
+#define IO_WRITER_APPEND 0x1
+#define IO_WRITER_WRITEV 0x2
+
+typedef struct io_writer io_writer;
+
+io_writer* io_writer_open(const char* filename, int flags, size_t buffer_size);
+int io_writer_write(io_writer* writer, const void* data, size_t size);
+int io_writer_write_text(io_writer* writer, const char* text);
+int io_writer_flush(io_writer* writer);
+int io_writer_sync(io_writer* writer);
+int io_writer_close(io_writer* writer);
+
 // Binary file operations
 int file_read_binary(const char* filename, void* buffer, size_t size);
 int file_write_binary(const char* filename, const void* data, size_t size);
 
+// Streaming reads: next_* return 1 with data, 0 at end of file, -1 on error
+#define IO_STREAM_DEFAULT_BUFFER_SIZE (256 * 1024)
+
+typedef struct io_stream io_stream;
+
+io_stream* io_stream_open(const char* filename, size_t buffer_size);
+int io_stream_next_chunk(io_stream* stream, const char** data, size_t* length);
+int io_stream_next_line(io_stream* stream, const char** line, size_t* length);
+void io_stream_close(io_stream* stream);
+
 // Directory operations
 int create_directory(const char* dirname);
 int remove_directory(const char* dirname);
 int list_directory(const char* dirname);
 
+// Recursive directory walks: the callback may run on several threads at once
+typedef struct {
+    const char* path;
+    size_t path_length;
+    unsigned char type;
+} dir_entry;
+
+typedef int (*dir_walk_callback)(const dir_entry* entry, void* context);
+
+typedef struct {
+    dir_entry* entries;
+    size_t count;
+    size_t capacity;
+    void* storage;
+} dir_listing;
+
+long dir_walk(const char* dirname, int threads, dir_walk_callback callback, void* context);
+int dir_walk_list(const char* dirname, int threads, dir_listing* listing);
+void dir_listing_free(dir_listing* listing);
+
 // Console I/O
 void print_line(const char* text);
 void print_number(int number);
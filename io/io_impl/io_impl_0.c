@@ -0,0 +1,324 @@
+#define _GNU_SOURCE
+#include "io.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define WALK_DENTS_BUFFER_SIZE (64 * 1024)
+#define WALK_MAX_THREADS 64
+#define LISTING_BLOCK_SIZE (64 * 1024)
+
+// A directory waiting to be read
+typedef struct walk_dir {
+    struct walk_dir* next;
+    size_t length;
+    char path[];
+} walk_dir;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    walk_dir* pending;
+    int active;             // workers reading a directory right now
+    int stop;               // the callback asked to stop, or the walk failed
+    int failed;             // out of memory: entries were left out
+    long count;
+    dir_walk_callback callback;
+    void* context;
+} walk_state;
+
+static walk_dir* walk_dir_new(const char* parent, size_t parent_length, const char* name, size_t name_length) {
+    size_t length = parent_length + 1 + name_length;
+    walk_dir* dir = malloc(sizeof(walk_dir) + length + 1);
+    if (!dir) return NULL;
+    memcpy(dir->path, parent, parent_length);
+    dir->path[parent_length] = '/';
+    memcpy(dir->path + parent_length + 1, name, name_length + 1);
+    dir->length = length;
+    return dir;
+}
+
+static unsigned char walk_type_of(int dir_fd, const char* name) {
+    struct stat st;
+    if (fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) return DT_UNKNOWN;
+    if (S_ISREG(st.st_mode)) return DT_REG;
+    if (S_ISDIR(st.st_mode)) return DT_DIR;
+    if (S_ISLNK(st.st_mode)) return DT_LNK;
+    if (S_ISFIFO(st.st_mode)) return DT_FIFO;
+    if (S_ISSOCK(st.st_mode)) return DT_SOCK;
+    if (S_ISCHR(st.st_mode)) return DT_CHR;
+    if (S_ISBLK(st.st_mode)) return DT_BLK;
+    return DT_UNKNOWN;
+}
+
+// Reports every entry of one directory and returns its subdirectories (not
+// followed through symlinks) as a list; *found counts the entries reported.
+// Sets *failed when an entry or subdirectory had to be left out.
+static walk_dir* walk_read_dir(walk_state* state, const walk_dir* dir, char* dents, char** path,
+                               size_t* path_capacity, long* found, int* stop, int* failed) {
+    walk_dir* subdirs = NULL;
+    int dir_fd = open(dir->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) return NULL;
+
+    for (;;) {
+        ssize_t n = getdents64(dir_fd, dents, WALK_DENTS_BUFFER_SIZE);
+        if (n <= 0) break;
+
+        for (ssize_t offset = 0; offset < n;) {
+            struct dirent64* d = (struct dirent64*)(dents + offset);
+            offset += d->d_reclen;
+
+            const char* name = d->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+
+            size_t name_length = strlen(name);
+            size_t length = dir->length + 1 + name_length;
+            if (length + 1 > *path_capacity) {
+                size_t capacity = (length + 1) * 2;
+                char* grown = realloc(*path, capacity);
+                if (!grown) {
+                    *failed = 1;
+                    close(dir_fd);
+                    return subdirs;
+                }
+                *path = grown;
+                *path_capacity = capacity;
+            }
+            memcpy(*path, dir->path, dir->length);
+            (*path)[dir->length] = '/';
+            memcpy(*path + dir->length + 1, name, name_length + 1);
+
+            dir_entry entry;
+            entry.path = *path;
+            entry.path_length = length;
+            entry.type = d->d_type == DT_UNKNOWN ? walk_type_of(dir_fd, name) : d->d_type;
+
+            (*found)++;
+            if (!state->callback(&entry, state->context)) {
+                *stop = 1;
+                close(dir_fd);
+                return subdirs;
+            }
+
+            if (entry.type == DT_DIR) {
+                walk_dir* subdir = walk_dir_new(dir->path, dir->length, name, name_length);
+                if (!subdir) {
+                    *failed = 1;
+                    close(dir_fd);
+                    return subdirs;
+                }
+                subdir->next = subdirs;
+                subdirs = subdir;
+            }
+        }
+    }
+
+    close(dir_fd);
+    return subdirs;
+}
+
+static void* walk_worker(void* arg) {
+    walk_state* state = arg;
+    char* dents = malloc(WALK_DENTS_BUFFER_SIZE);
+    size_t path_capacity = 4096;
+    char* path = malloc(path_capacity);
+    long found = 0;
+
+    pthread_mutex_lock(&state->lock);
+    if (!dents || !path) {
+        state->failed = 1;
+        state->stop = 1;
+    }
+    for (;;) {
+        while (!state->pending && state->active > 0 && !state->stop) {
+            pthread_cond_wait(&state->ready, &state->lock);
+        }
+        if (!state->pending || state->stop) break;
+
+        walk_dir* dir = state->pending;
+        state->pending = dir->next;
+        state->active++;
+        pthread_mutex_unlock(&state->lock);
+
+        int stop = 0, failed = 0;
+        walk_dir* subdirs = walk_read_dir(state, dir, dents, &path, &path_capacity, &found, &stop, &failed);
+        free(dir);
+
+        pthread_mutex_lock(&state->lock);
+        state->active--;
+        if (stop || failed) state->stop = 1;
+        if (failed) state->failed = 1;
+        while (subdirs) {
+            walk_dir* next = subdirs->next;
+            subdirs->next = state->pending;
+            state->pending = subdirs;
+            subdirs = next;
+        }
+        pthread_cond_broadcast(&state->ready);
+    }
+    state->count += found;
+    pthread_cond_broadcast(&state->ready);
+    pthread_mutex_unlock(&state->lock);
+
+    free(dents);
+    free(path);
+    return NULL;
+}
+
+long dir_walk(const char* dirname, int threads, dir_walk_callback callback, void* context) {
+    if (!dirname || !callback) return -1;
+
+    // The root must be a readable directory; anything unreadable below it is
+    // skipped
+    int root_fd = open(dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) return -1;
+    close(root_fd);
+
+    size_t length = strlen(dirname);
+    while (length > 1 && dirname[length - 1] == '/') length--;
+    walk_dir* root = malloc(sizeof(walk_dir) + length + 1);
+    if (!root) return -1;
+    memcpy(root->path, dirname, length);
+    root->path[length] = '\0';
+    // "/" would otherwise produce "//name"
+    root->length = (length == 1 && dirname[0] == '/') ? 0 : length;
+    root->next = NULL;
+
+    walk_state state;
+    pthread_mutex_init(&state.lock, NULL);
+    pthread_cond_init(&state.ready, NULL);
+    state.pending = root;
+    state.active = 0;
+    state.stop = 0;
+    state.failed = 0;
+    state.count = 0;
+    state.callback = callback;
+    state.context = context;
+
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads > WALK_MAX_THREADS) threads = WALK_MAX_THREADS;
+
+    // The calling thread is one of the workers
+    pthread_t workers[WALK_MAX_THREADS];
+    int started = 0;
+    while (started < threads - 1 && pthread_create(&workers[started], NULL, walk_worker, &state) == 0) {
+        started++;
+    }
+    walk_worker(&state);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    // A stopped walk can leave directories behind
+    while (state.pending) {
+        walk_dir* next = state.pending->next;
+        free(state.pending);
+        state.pending = next;
+    }
+    pthread_cond_destroy(&state.ready);
+    pthread_mutex_destroy(&state.lock);
+    return state.failed ? -1 : state.count;
+}
+
+// Paths are copied into blocks that never move, so entries can point at them
+typedef struct listing_block {
+    struct listing_block* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} listing_block;
+
+typedef struct {
+    pthread_mutex_t lock;
+    dir_listing* listing;
+    int failed;
+} listing_state;
+
+static char* listing_store(dir_listing* listing, const char* path, size_t length) {
+    listing_block* block = listing->storage;
+    if (!block || block->capacity - block->used < length + 1) {
+        size_t capacity = length + 1 > LISTING_BLOCK_SIZE ? length + 1 : LISTING_BLOCK_SIZE;
+        listing_block* fresh = malloc(sizeof(listing_block) + capacity);
+        if (!fresh) return NULL;
+        fresh->next = block;
+        fresh->used = 0;
+        fresh->capacity = capacity;
+        listing->storage = fresh;
+        block = fresh;
+    }
+    char* copy = block->data + block->used;
+    memcpy(copy, path, length + 1);
+    block->used += length + 1;
+    return copy;
+}
+
+static int listing_add(const dir_entry* entry, void* context) {
+    listing_state* state = context;
+    dir_listing* listing = state->listing;
+
+    pthread_mutex_lock(&state->lock);
+    if (listing->count == listing->capacity) {
+        size_t capacity = listing->capacity ? listing->capacity * 2 : 1024;
+        dir_entry* entries = realloc(listing->entries, capacity * sizeof(dir_entry));
+        if (!entries) {
+            state->failed = 1;
+            pthread_mutex_unlock(&state->lock);
+            return 0;
+        }
+        listing->entries = entries;
+        listing->capacity = capacity;
+    }
+    char* path = listing_store(listing, entry->path, entry->path_length);
+    if (!path) {
+        state->failed = 1;
+        pthread_mutex_unlock(&state->lock);
+        return 0;
+    }
+    dir_entry* copy = &listing->entries[listing->count++];
+    copy->path = path;
+    copy->path_length = entry->path_length;
+    copy->type = entry->type;
+    pthread_mutex_unlock(&state->lock);
+    return 1;
+}
+
+int dir_walk_list(const char* dirname, int threads, dir_listing* listing) {
+    if (!listing) return 0;
+    listing->entries = NULL;
+    listing->count = 0;
+    listing->capacity = 0;
+    listing->storage = NULL;
+
+    listing_state state;
+    pthread_mutex_init(&state.lock, NULL);
+    state.listing = listing;
+    state.failed = 0;
+
+    long count = dir_walk(dirname, threads, listing_add, &state);
+    pthread_mutex_destroy(&state.lock);
+    if (count < 0 || state.failed) {
+        dir_listing_free(listing);
+        return 0;
+    }
+    return 1;
+}
+
+void dir_listing_free(dir_listing* listing) {
+    if (!listing) return;
+    listing_block* block = listing->storage;
+    while (block) {
+        listing_block* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(listing->entries);
+    listing->entries = NULL;
+    listing->count = 0;
+    listing->capacity = 0;
+    listing->storage = NULL;
+}
@@ -0,0 +1,26 @@
+#include "io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int file_exists(const char* filename) {
+    if (!filename) return 0;
+    struct stat st;
+    return stat(filename, &st) == 0;
+}
+
+long file_size(const char* filename) {
+    if (!filename) return -1;
+    struct stat st;
+    if (stat(filename, &st) == 0) {
+        return st.st_size;
+    }
+    return -1;
+}
+
+int file_delete(const char* filename) {
+    if (!filename) return 0;
+    return remove(filename) == 0;
+}
@@ -0,0 +1,131 @@
+#include "io.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct io_stream {
+    int fd;
+    char* buffer;      // capacity bytes plus room for a terminating NUL
+    size_t capacity;
+    size_t start;      // unconsumed bytes are buffer[start..end)
+    size_t end;
+    int eof;
+};
+
+io_stream* io_stream_open(const char* filename, size_t buffer_size) {
+    if (!filename) return NULL;
+    if (buffer_size == 0) buffer_size = IO_STREAM_DEFAULT_BUFFER_SIZE;
+    
+    io_stream* stream = malloc(sizeof(io_stream));
+    if (!stream) return NULL;
+    
+    stream->buffer = malloc(buffer_size + 1);
+    if (!stream->buffer) {
+        free(stream);
+        return NULL;
+    }
+    
+    stream->fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (stream->fd < 0) {
+        free(stream->buffer);
+        free(stream);
+        return NULL;
+    }
+    
+    // Only a hint: larger readahead for a front-to-back read
+    posix_fadvise(stream->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    stream->capacity = buffer_size;
+    stream->start = 0;
+    stream->end = 0;
+    stream->eof = 0;
+    return stream;
+}
+
+// Reads once into the free space after end: 1 if bytes arrived, 0 at end of
+// file, -1 on error
+static int io_stream_fill(io_stream* stream) {
+    if (stream->eof) return 0;
+    for (;;) {
+        ssize_t n = read(stream->fd, stream->buffer + stream->end, stream->capacity - stream->end);
+        if (n > 0) {
+            stream->end += (size_t)n;
+            return 1;
+        }
+        if (n == 0) {
+            stream->eof = 1;
+            return 0;
+        }
+        if (errno != EINTR) return -1;
+    }
+}
+
+int io_stream_next_chunk(io_stream* stream, const char** data, size_t* length) {
+    if (!stream || !data || !length) return -1;
+    
+    // Bytes left behind by io_stream_next_line come first
+    if (stream->start == stream->end) {
+        stream->start = 0;
+        stream->end = 0;
+        int result = io_stream_fill(stream);
+        if (result <= 0) return result;
+    }
+    
+    *data = stream->buffer + stream->start;
+    *length = stream->end - stream->start;
+    stream->start = stream->end;
+    return 1;
+}
+
+int io_stream_next_line(io_stream* stream, const char** line, size_t* length) {
+    if (!stream || !line || !length) return -1;
+    
+    size_t scanned = stream->start;
+    for (;;) {
+        char* newline = memchr(stream->buffer + scanned, '\n', stream->end - scanned);
+        if (newline) {
+            *newline = '\0';
+            *line = stream->buffer + stream->start;
+            *length = (size_t)(newline - *line);
+            stream->start = (size_t)(newline - stream->buffer) + 1;
+            return 1;
+        }
+        
+        // Slide the partial line to the front, growing the buffer only for a
+        // line longer than it
+        size_t pending = stream->end - stream->start;
+        if (stream->start > 0) {
+            memmove(stream->buffer, stream->buffer + stream->start, pending);
+            stream->start = 0;
+            stream->end = pending;
+        } else if (stream->end == stream->capacity) {
+            size_t capacity = stream->capacity * 2;
+            char* buffer = realloc(stream->buffer, capacity + 1);
+            if (!buffer) return -1;
+            stream->buffer = buffer;
+            stream->capacity = capacity;
+        }
+        scanned = pending;
+        
+        int result = io_stream_fill(stream);
+        if (result < 0) return -1;
+        if (result == 0) {
+            // The last line need not end in a newline
+            if (pending == 0) return 0;
+            stream->buffer[pending] = '\0';
+            *line = stream->buffer;
+            *length = pending;
+            stream->start = pending;
+            return 1;
+        }
+    }
+}
+
+void io_stream_close(io_stream* stream) {
+    if (!stream) return;
+    close(stream->fd);
+    free(stream->buffer);
+    free(stream);
+}
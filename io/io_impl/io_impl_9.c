@@ -0,0 +1,40 @@
+#include "io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void print_line(const char* text) {
+    if (text) {
+        printf("%s\n", text);
+    }
+}
+
+void print_number(int number) {
+    printf("%d\n", number);
+}
+
+void print_float(double number) {
+    printf("%.2f\n", number);
+}
+
+int read_line(char* buffer, size_t buffer_size) {
+    if (!buffer || buffer_size == 0) return 0;
+    
+    if (fgets(buffer, buffer_size, stdin)) {
+        // Remove newline if present
+        size_t len = strlen(buffer);
+        if (len > 0 && buffer[len - 1] == '\n') {
+            buffer[len - 1] = '\0';
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int read_number(void) {
+    int number;
+    if (scanf("%d", &number) == 1) {
+        return number;
+    }
+    return 0;
+}
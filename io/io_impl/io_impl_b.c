@@ -0,0 +1,25 @@
+#include "io.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int file_read_binary(const char* filename, void* buffer, size_t size) {
+    if (!filename || !buffer || size == 0) return 0;
+    
+    FILE* file = fopen(filename, "rb");
+    if (!file) return 0;
+    
+    size_t bytes_read = fread(buffer, 1, size, file);
+    fclose(file);
+    return bytes_read == size;
+}
+
+int file_write_binary(const char* filename, const void* data, size_t size) {
+    if (!filename || !data || size == 0) return 0;
+    
+    FILE* file = fopen(filename, "wb");
+    if (!file) return 0;
+    
+    size_t bytes_written = fwrite(data, 1, size, file);
+    fclose(file);
+    return bytes_written == size;
+}
@@ -0,0 +1,133 @@
+#include "io.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+struct io_writer {
+    int fd;
+    int flags;
+    char* buffer;
+    size_t capacity;
+    size_t used;
+    int failed;        // a write failed; buffered data may be lost
+};
+
+io_writer* io_writer_open(const char* filename, int flags, size_t buffer_size) {
+    if (!filename) return NULL;
+    if (buffer_size == 0) buffer_size = IO_WRITER_DEFAULT_BUFFER_SIZE;
+    
+    io_writer* writer = malloc(sizeof(io_writer));
+    if (!writer) return NULL;
+    
+    writer->buffer = malloc(buffer_size);
+    if (!writer->buffer) {
+        free(writer);
+        return NULL;
+    }
+    
+    int open_flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+    open_flags |= (flags & IO_WRITER_APPEND) ? O_APPEND : O_TRUNC;
+    writer->fd = open(filename, open_flags, 0666);
+    if (writer->fd < 0) {
+        free(writer->buffer);
+        free(writer);
+        return NULL;
+    }
+    
+    writer->flags = flags;
+    writer->capacity = buffer_size;
+    writer->used = 0;
+    writer->failed = 0;
+    return writer;
+}
+
+// Writes every byte of iov[0..count), resuming after short writes
+static int io_writer_write_all(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t n = writev(fd, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        while (count > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return 1;
+}
+
+int io_writer_flush(io_writer* writer) {
+    if (!writer) return 0;
+    if (writer->used > 0) {
+        struct iovec iov = { writer->buffer, writer->used };
+        writer->used = 0;
+        if (!io_writer_write_all(writer->fd, &iov, 1)) writer->failed = 1;
+    }
+    return !writer->failed;
+}
+
+int io_writer_write(io_writer* writer, const void* data, size_t size) {
+    if (!writer || (!data && size > 0)) return 0;
+    if (writer->failed) return 0;
+    
+    if (size <= writer->capacity - writer->used) {
+        memcpy(writer->buffer + writer->used, data, size);
+        writer->used += size;
+        return 1;
+    }
+    
+    if (writer->flags & IO_WRITER_WRITEV) {
+        // The buffered bytes and the new data leave in a single system call
+        struct iovec iov[2] = {
+            { writer->buffer, writer->used },
+            { (void*)data, size }
+        };
+        writer->used = 0;
+        if (!io_writer_write_all(writer->fd, iov, 2)) writer->failed = 1;
+        return !writer->failed;
+    }
+    
+    if (!io_writer_flush(writer)) return 0;
+    if (size < writer->capacity) {
+        memcpy(writer->buffer, data, size);
+        writer->used = size;
+        return 1;
+    }
+    struct iovec iov = { (void*)data, size };
+    if (!io_writer_write_all(writer->fd, &iov, 1)) writer->failed = 1;
+    return !writer->failed;
+}
+
+int io_writer_write_text(io_writer* writer, const char* text) {
+    if (!text) return 0;
+    return io_writer_write(writer, text, strlen(text));
+}
+
+int io_writer_sync(io_writer* writer) {
+    if (!io_writer_flush(writer)) return 0;
+    while (fsync(writer->fd) != 0) {
+        if (errno != EINTR) {
+            writer->failed = 1;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int io_writer_close(io_writer* writer) {
+    if (!writer) return 0;
+    int result = io_writer_flush(writer);
+    if (close(writer->fd) != 0) result = 0;
+    free(writer->buffer);
+    free(writer);
+    return result;
+}
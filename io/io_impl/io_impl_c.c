@@ -0,0 +1,39 @@
+#include "io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int file_read_text(const char* filename, char* buffer, size_t buffer_size) {
+    if (!filename || !buffer || buffer_size == 0) return 0;
+    
+    FILE* file = fopen(filename, "r");
+    if (!file) return 0;
+    
+    size_t bytes_read = fread(buffer, 1, buffer_size - 1, file);
+    buffer[bytes_read] = '\0';
+    
+    fclose(file);
+    return bytes_read > 0;
+}
+
+int file_write_text(const char* filename, const char* content) {
+    if (!filename || !content) return 0;
+    
+    FILE* file = fopen(filename, "w");
+    if (!file) return 0;
+    
+    int result = fputs(content, file) != EOF;
+    fclose(file);
+    return result;
+}
+
+int file_append_text(const char* filename, const char* content) {
+    if (!filename || !content) return 0;
+    
+    FILE* file = fopen(filename, "a");
+    if (!file) return 0;
+    
+    int result = fputs(content, file) != EOF;
+    fclose(file);
+    return result;
+}
@@ -0,0 +1,36 @@
+#include "io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
+
+int create_directory(const char* dirname) {
+    if (!dirname) return 0;
+    return mkdir(dirname, 0755) == 0;
+}
+
+int remove_directory(const char* dirname) {
+    if (!dirname) return 0;
+    return rmdir(dirname) == 0;
+}
+
+int list_directory(const char* dirname) {
+    if (!dirname) return 0;
+    
+    DIR* dir = opendir(dirname);
+    if (!dir) return 0;
+    
+    struct dirent* entry;
+    int count = 0;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            printf("%s\n", entry->d_name);
+            count++;
+        }
+    }
+    
+    closedir(dir);
+    return count;
+}
@@ -0,0 +1,2 @@
+# Generated by generate_io.py, do not edit
+GENERATED_SOURCES = io_impl/io_impl_0.c io_impl/io_impl_6.c io_impl/io_impl_6_1.c io_impl/io_impl_8.c io_impl/io_impl_9.c io_impl/io_impl_b.c io_impl/io_impl_b_1.c io_impl/io_impl_c.c io_impl/io_impl_e.c
@@ -49,6 +49,18 @@ int main(void) {
     printf("Count 'l' in 'Hello': %d\n", str_count("Hello", 'l'));
     printf("Is '12345' numeric: %d\n", str_is_numeric("12345"));
     printf("Is 'Hello' alpha: %d\n", str_is_alpha("Hello"));
+    
+    strbuf built;
+    strbuf_init(&built);
+    strbuf_append(&built, str1);
+    strbuf_append_char(&built, ' ');
+    strbuf_append(&built, str2);
+    strbuf_append(&built, " x");
+    strbuf_append_int(&built, a);
+    strbuf_append(&built, " = ");
+    strbuf_append_double(&built, divide(15.0, 4.0), 2);
+    printf("Built: %s (%zu chars)\n", strbuf_cstr(&built), built.length);
+    strbuf_free(&built);
     printf("\n");
     
     // IO module demonstration
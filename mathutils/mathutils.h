@@ -0,0 +1,20 @@
+#ifndef MATH_H
+#define MATH_H
+
+// Basic arithmetic operations
+int add(int a, int b);
+int subtract(int a, int b);
+int multiply(int a, int b);
+double divide(double a, double b);
+
+// Advanced math functions
+int power(int base, int exponent);
+int factorial(int n);
+int gcd(int a, int b);
+int lcm(int a, int b);
+
+// Utility functions
+int is_prime(int n);
+int fibonacci(int n);
+
+#endif // MATH_H
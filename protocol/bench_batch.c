@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Messages per second for DataPacket streams: batches of 1 to 64k through
+// encode_DataPacket_batch/decode_DataPacket_batch, against one
+// encode_DataPacket/decode_DataPacket call per message.
+//
+// Usage: bench_batch [payload_bytes] [messages_per_size]
+
+#include PROTOCOL_HEADER
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Keeps the compiler from dropping work whose result is otherwise unused
+static volatile size_t sink;
+
+static double bench_single(const DataPacket* msgs, size_t batch, size_t reps) {
+    size_t total = 0;
+    double start = now();
+    for (size_t r = 0; r < reps; r++) {
+        for (size_t i = 0; i < batch; i++) {
+            size_t len;
+            char* data = encode_DataPacket(&msgs[i], &len);
+            DataPacket* decoded = decode_DataPacket(data, len);
+            total += decoded->payload_len;
+            free_DataPacket(decoded);
+            free(data);
+        }
+    }
+    double elapsed = now() - start;
+    sink = total;
+    return elapsed;
+}
+
+static int bench_batch(const DataPacket* msgs, size_t batch, size_t reps, char* arena, size_t cap,
+                       DataPacket_view* views, double* encode_time, double* decode_time) {
+    size_t used = 0;
+    double start = now();
+    for (size_t r = 0; r < reps; r++) {
+        used = encode_DataPacket_batch(msgs, batch, arena, cap);
+        if (used == 0) {
+            fprintf(stderr, "Error: encode_DataPacket_batch failed for a batch of %zu\n", batch);
+            return 0;
+        }
+    }
+    *encode_time = now() - start;
+
+    size_t total = 0;
+    start = now();
+    for (size_t r = 0; r < reps; r++) {
+        size_t count, consumed;
+        if (!decode_DataPacket_batch(arena, used, views, batch, &count, &consumed) || count != batch) {
+            fprintf(stderr, "Error: decode_DataPacket_batch failed for a batch of %zu\n", batch);
+            return 0;
+        }
+        total += views[count - 1].payload_len;
+    }
+    *decode_time = now() - start;
+    sink = total;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    size_t payload_len = argc > 1 ? strtoul(argv[1], NULL, 10) : 64;
+    size_t messages = argc > 2 ? strtoul(argv[2], NULL, 10) : 1 << 22;
+    const size_t max_batch = 1 << 16;
+
+    char* payload = malloc(payload_len + 1);
+    DataPacket* msgs = malloc(max_batch * sizeof(DataPacket));
+    DataPacket_view* views = malloc(max_batch * sizeof(DataPacket_view));
+    if (!payload || !msgs || !views) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < payload_len; i++) {
+        payload[i] = (char)('a' + i % 26);
+    }
+    payload[payload_len] = '\0';
+    for (size_t i = 0; i < max_batch; i++) {
+        msgs[i] = (DataPacket){.id = (int)i, .payload = payload, .payload_len = payload_len, .size = (int)payload_len};
+    }
+
+    size_t cap = encoded_batch_size_DataPacket(msgs, max_batch);
+    char* arena = malloc(cap);
+    if (!arena) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    printf("DataPacket, %zu-byte payload, %zu messages per batch size (messages/sec)\n", payload_len, messages);
+    printf("%8s %14s %14s %14s\n", "batch", "encode_batch", "decode_batch", "single");
+    for (size_t batch = 1; batch <= max_batch; batch *= 4) {
+        size_t reps = messages / batch ? messages / batch : 1;
+        double encode_time, decode_time;
+        if (!bench_batch(msgs, batch, reps, arena, cap, views, &encode_time, &decode_time)) {
+            return 1;
+        }
+        double single_time = bench_single(msgs, batch, reps);
+        double n = (double)batch * reps;
+        printf("%8zu %14.0f %14.0f %14.0f\n", batch, n / encode_time, n / decode_time, n / single_time);
+    }
+
+    free(arena);
+    free(views);
+    free(msgs);
+    free(payload);
+    return 0;
+}
@@ -5,6 +5,7 @@
 import hashlib
 import sys
 import os
+import tempfile
 import re
 
 def md5sum(text):
@@ -14,6 +15,58 @@ def create_proto_impl_dir():
     if not os.path.exists('proto_impl'):
         os.makedirs('proto_impl')
 
+def write_if_changed(path, content):
+    """Write content to path unless it already holds exactly that, so unchanged outputs keep their mtime"""
+    try:
+        with open(path, 'r') as f:
+            if f.read() == content:
+                return False
+    except FileNotFoundError:
+        pass
+    # A temporary name of its own, so concurrent runs never share one
+    fd, tmp_path = tempfile.mkstemp(dir=os.path.dirname(path) or '.', prefix=os.path.basename(path) + '.')
+    try:
+        with os.fdopen(fd, 'w') as f:
+            f.write(content)
+        os.chmod(tmp_path, 0o644)
+        os.replace(tmp_path, path)
+    except BaseException:
+        os.unlink(tmp_path)
+        raise
+    return True
+
+def read_manifest(manifest_path):
+    """Return every file listed in a manifest from a previous run"""
+    files = set()
+    try:
+        with open(manifest_path, 'r') as f:
+            for line in f:
+                if '=' in line and not line.startswith('#'):
+                    files.update(line.split('=', 1)[1].split())
+    except FileNotFoundError:
+        pass
+    return files
+
+def write_manifest(manifest_path, variables):
+    """Write a makefile fragment listing the outputs. Rewritten only when the
+    list changes; otherwise just touched so make sees it as up to date."""
+    content = '# Generated by generate_protocol.py, do not edit\n'
+    for name, files in variables:
+        content += f"{name} = {' '.join(files)}\n"
+    if not write_if_changed(manifest_path, content):
+        os.utime(manifest_path)
+
+def emit(path, content, generated):
+    if write_if_changed(path, content):
+        print(f"Generated: {path}")
+    else:
+        print(f"Unchanged: {path}")
+    generated.append(path)
+
+# Wire formats a MESSAGE can choose in protocol.spec: '|'-separated text, or
+# little-endian binary with length-prefixed strings
+WIRE_FORMATS = ('text', 'binary')
+
 def parse_protocol_spec(spec_file):
     """Parse protocol.spec and return list of messages with their fields"""
     messages = []
@@ -28,8 +81,13 @@ def parse_protocol_spec(spec_file):
             if line.startswith('MESSAGE'):
                 if current_message:
                     messages.append(current_message)
-                message_name = line.split()[1]
-                current_message = {'name': message_name, 'fields': []}
+                parts = line.split()
+                message_name = parts[1]
+                wire_format = parts[2] if len(parts) > 2 else 'text'
+                if wire_format not in WIRE_FORMATS:
+                    print(f"Error: Unknown wire format '{wire_format}' for message {message_name}")
+                    sys.exit(1)
+                current_message = {'name': message_name, 'format': wire_format, 'fields': []}
             elif line.startswith('FIELD') and current_message:
                 parts = line.split()
                 field_name = parts[1]
@@ -50,111 +108,577 @@ def c_type_for_field(field_type):
     else:
         return 'void*'
 
+def string_fields(message):
+    return [field for field in message['fields'] if field['type'] == 'string']
+
+def message_tag(message):
+    """32-bit type tag that starts every binary message"""
+    return '0x' + md5sum(message['name'])[:8] + 'u'
+
+DECODE_HELPERS = '''/* Decoder helpers: a bounded decimal int parse (no NUL terminator needed)
+   and a NUL-terminated copy of a field */
+static inline int proto_parse_int(const char* s, size_t len, int* out) {
+    size_t i = 0;
+    int negative = 0;
+    unsigned long value = 0;
+    if (len > 0 && (s[0] == '-' || s[0] == '+')) {
+        negative = s[0] == '-';
+        i = 1;
+    }
+    if (i == len) return 0;
+    for (; i < len; i++) {
+        if (s[i] < '0' || s[i] > '9') return 0;
+        value = value * 10 + (unsigned long)(s[i] - '0');
+        if (value > (unsigned long)INT_MAX + 1) return 0;
+    }
+    if (!negative && value > (unsigned long)INT_MAX) return 0;
+    *out = negative ? (int)(0 - (long)value) : (int)value;
+    return 1;
+}
+
+static inline char* proto_strndup(const char* s, size_t len) {
+    char* copy = (char*)malloc(len + 1);
+    if (!copy) return NULL;
+    if (len) memcpy(copy, s, len);
+    copy[len] = '\\0';
+    return copy;
+}
+
+'''
+
+TEXT_HELPERS = '''/* Text encoder helpers: the length of an int in decimal, and writing it */
+static inline size_t proto_int_len(int value) {
+    unsigned int u = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    size_t len = value < 0 ? 2 : 1;
+    while (u >= 10) {
+        u /= 10;
+        len++;
+    }
+    return len;
+}
+
+static inline size_t proto_put_int(char* p, int value) {
+    unsigned int u = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    size_t len = proto_int_len(value);
+    char* q = p + len;
+    do {
+        *--q = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0) *p = '-';
+    return len;
+}
+
+'''
+
+WORD_HELPERS = '''/* 32-bit little-endian words, used by the binary format and batch frames */
+static inline void proto_put_u32(char* p, uint32_t value) {
+    unsigned char* b = (unsigned char*)p;
+    b[0] = (unsigned char)value;
+    b[1] = (unsigned char)(value >> 8);
+    b[2] = (unsigned char)(value >> 16);
+    b[3] = (unsigned char)(value >> 24);
+}
+
+static inline uint32_t proto_get_u32(const char* p) {
+    const unsigned char* b = (const unsigned char*)p;
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+'''
+
+BINARY_HELPERS = '''/* Binary wire format: a 32-bit type tag, then every field in spec order;
+   ints are 32-bit little-endian, strings a 32-bit length and their bytes.
+   A string field's length is its _len member, or strlen when that is 0 */
+static inline size_t proto_str_len(const char* s, size_t len) {
+    return len ? len : (s ? strlen(s) : 0);
+}
+
+'''
+
+API_DOC = '''/* Every message X gets:
+   - X, owning its strings, and X_view, filled in place by decode_X_view with
+     pointer+length views into the encoded buffer (not NUL-terminated)
+   - encode_X, returning a malloc'd encoding, and decode_X/free_X
+   - encoded_size_X, the exact encoded size (0 if it cannot be encoded: a
+     text string containing '|', or a binary one over 4 GB), and
+     encode_X_into, writing it to buf and returning it (0 if cap is too small)
+   - batches: runs of frames, each a 32-bit little-endian length and one
+     encoded message.  encode_X_batch writes count messages to the arena and
+     returns the bytes used (0 if they do not fit), encoded_batch_size_X is
+     that size up front.  decode_X_batch fills up to max_count views from
+     whole frames, leaving a trailing partial frame for the next call; it
+     returns 0 on a malformed frame, with count and used covering the frames
+     before it
+   - decode_X_arena, decoding like decode_X but taking the struct and its
+     strings from the arena (from the heap, as decode_X, when it is NULL);
+     such a message must not be passed to free_X.  decode_X_batch_arena
+     decodes every whole frame of a batch into one array in the arena, with
+     the same count, used and return value as decode_X_batch
+   Binary messages also get encode_X_iov, filling at most X_IOV_MAX iovecs
+   with fixed-size fields taken from scratch (X_SCRATCH_SIZE bytes) and
+   strings in place */
+
+'''
+
+def wrap_header(header_guard, body):
+    return '\n#ifndef ' + header_guard + '\n#define ' + header_guard + '\n\n' + body + \
+        '\n#endif /* ' + header_guard + ' */\n'
+
+def header_prologue():
+    """Includes, inline helpers and the API description shared by every message"""
+    prologue = '#include <stddef.h>\n#include "utils.h"\n'
+    prologue += '#include <limits.h>\n#include <stdint.h>\n#include <stdlib.h>\n#include <string.h>\n'
+    prologue += '#include <sys/uio.h>\n\n'
+    return prologue + WORD_HELPERS + DECODE_HELPERS + TEXT_HELPERS + BINARY_HELPERS + API_DOC
+
+def message_declarations(msg):
+    """Structs and function declarations of one message"""
+    name = msg['name']
+
+    # Binary messages carry an explicit length for every string so payloads
+    # need not be NUL-terminated
+    header = f'/* {name} message structure */\n'
+    header += f'typedef struct {{\n'
+    for field in msg['fields']:
+        c_type = c_type_for_field(field['type'])
+        header += f'    {c_type} {field["name"]};\n'
+        if msg['format'] == 'binary' and field['type'] == 'string':
+            header += f'    size_t {field["name"]}_len;\n'
+    header += f'}} {name};\n\n'
+
+    header += f'/* {name} view into an encoded message */\n'
+    header += f'typedef struct {{\n'
+    for field in msg['fields']:
+        if field['type'] == 'string':
+            header += f'    const char* {field["name"]};\n'
+            header += f'    size_t {field["name"]}_len;\n'
+        else:
+            header += f'    {c_type_for_field(field["type"])} {field["name"]};\n'
+    header += f'}} {name}_view;\n\n'
+
+    header += f'''char* encode_{name}(const {name}* msg, size_t* out_len);
+{name}* decode_{name}(const char* data, size_t len);
+void free_{name}({name}* msg);
+int decode_{name}_view(const char* data, size_t len, {name}_view* view);
+size_t encoded_size_{name}(const {name}* msg);
+size_t encode_{name}_into(const {name}* msg, char* buf, size_t cap);
+size_t encoded_batch_size_{name}(const {name}* msgs, size_t count);
+size_t encode_{name}_batch(const {name}* msgs, size_t count, char* arena, size_t cap);
+int decode_{name}_batch(const char* data, size_t len, {name}_view* views, size_t max_count,
+{' ' * len(f'int decode_{name}_batch(')}size_t* count, size_t* used);
+{name}* decode_{name}_arena(const char* data, size_t len, arena* a);
+int decode_{name}_batch_arena(const char* data, size_t len, arena* a, {name}** msgs,
+{' ' * len(f'int decode_{name}_batch_arena(')}size_t* count, size_t* used);
+'''
+    if msg['format'] == 'binary':
+        header += f'''
+#define {name}_TAG {message_tag(msg)}
+#define {name}_IOV_MAX {2 * len(string_fields(msg)) + 1}
+#define {name}_SCRATCH_SIZE {4 + 4 * len(msg["fields"])}
+int encode_{name}_iov(const {name}* msg, char* scratch, struct iovec* iov);
+'''
+    return header + '\n'
+
 def generate_header(messages, header_guard):
     """Generate protocol header with struct definitions based on spec"""
-    header = '''
-#ifndef ''' + header_guard + '''
-#define ''' + header_guard + '''
+    body = header_prologue()
+    for msg in messages:
+        body += message_declarations(msg)
+    return wrap_header(header_guard, body)
+
+def generate_message_header(message, header_guard, common_header):
+    """Per-message layout: one message's declarations over the common header"""
+    return wrap_header(header_guard, f'#include "{common_header}"\n\n' + message_declarations(message))
+
+def generate_umbrella_header(header_guard, message_headers):
+    """Per-message layout: the header users include, pulling in every message"""
+    return wrap_header(header_guard, ''.join(f'#include "{name}"\n' for name in message_headers))
 
-#include <stddef.h>
+def message_ids(messages, seed):
+    """Per-message layout: a name for each message's files from a hash of the
+    seed and the message name, so it does not move when other messages are
+    added, removed or reordered; lengthened until no two messages share one"""
+    length = {msg['name']: 8 for msg in messages}
+    while True:
+        ids = {name: md5sum(f'{seed}:{name}')[:length[name]] for name in length}
+        by_id = {}
+        for name, message_id in ids.items():
+            by_id.setdefault(message_id, []).append(name)
+        clashes = [names for names in by_id.values() if len(names) > 1]
+        if not clashes:
+            return ids
+        for names in clashes:
+            for name in names:
+                length[name] += 1
 
+def field_lengths(message):
+    """Code computing every string field's length into <field>_len, returning
+    0 for a field the format cannot carry: a binary string over the 32-bit
+    length prefix, or a text string containing the '|' separator"""
+    code = ''
+    for field in string_fields(message):
+        name = field['name']
+        if message['format'] == 'binary':
+            code += f'    size_t {name}_len = proto_str_len(msg->{name}, msg->{name}_len);\n'
+            code += f'    if ({name}_len > UINT32_MAX) return 0;\n'
+        else:
+            code += f'    size_t {name}_len = msg->{name} ? strlen(msg->{name}) : 0;\n'
+            code += f"    if ({name}_len && memchr(msg->{name}, '|', {name}_len)) return 0;\n"
+    return code
+
+def encoded_size(message):
+    """C expression for the encoded size, given field_lengths"""
+    if message['format'] == 'binary':
+        terms = ['4'] + [f'4 + {field["name"]}_len' if field['type'] == 'string' else '4'
+                         for field in message['fields']]
+    else:
+        terms = [f'sizeof("{message["name"]}|") - 1']
+        for field in message['fields']:
+            if field['type'] == 'string':
+                terms.append(f'{field["name"]}_len + 1')
+            elif field['type'] == 'int':
+                terms.append(f'proto_int_len(msg->{field["name"]}) + 1')
+    return ' + '.join(terms)
+
+def encode_fields(message):
+    """Body of encode_X_into writing every field at p"""
+    name = message['name']
+    if message['format'] == 'binary':
+        code = f'''    proto_put_u32(p, {name}_TAG);
+    p += 4;
 '''
-    
-    # Generate struct for each message
-    for msg in messages:
-        header += f'/* {msg["name"]} message structure */\n'
-        header += f'typedef struct {{\n'
-        for field in msg['fields']:
-            c_type = c_type_for_field(field['type'])
-            header += f'    {c_type} {field["name"]};\n'
-        header += f'}} {msg["name"]};\n\n'
-    
-    # Generate encode/decode function declarations
-    header += '/* Encode/decode function declarations */\n'
-    for msg in messages:
-        header += f'char* encode_{msg["name"]}(const {msg["name"]}* msg, size_t* out_len);\n'
-        header += f'{msg["name"]}* decode_{msg["name"]}(const char* data, size_t len);\n'
-        header += f'void free_{msg["name"]}({msg["name"]}* msg);\n'
-    
-    header += '\n#endif /* ' + header_guard + ' */\n'
-    return header
+    else:
+        code = f'''    memcpy(p, "{name}|", sizeof("{name}|") - 1);
+    p += sizeof("{name}|") - 1;
+'''
+    for field in message['fields']:
+        fname = field['name']
+        if message['format'] == 'binary':
+            if field['type'] == 'string':
+                code += f'''    proto_put_u32(p, (uint32_t){fname}_len);
+    p += 4;
+    if ({fname}_len) memcpy(p, msg->{fname}, {fname}_len);
+    p += {fname}_len;
+'''
+            elif field['type'] == 'int':
+                code += f'''    proto_put_u32(p, (uint32_t)msg->{fname});
+    p += 4;
+'''
+        else:
+            if field['type'] == 'string':
+                code += f'''    if ({fname}_len) memcpy(p, msg->{fname}, {fname}_len);
+    p += {fname}_len;
+    *p++ = '|';
+'''
+            elif field['type'] == 'int':
+                code += f'''    p += proto_put_int(p, msg->{fname});
+    *p++ = '|';
+'''
+    return code
+
+def generate_iov_encoder(message):
+    """encode_X_iov for a binary message: fixed-size fields go to scratch,
+    strings are referenced in place"""
+    name = message['name']
+    code = f'''
+int encode_{name}_iov(const {name}* msg, char* scratch, struct iovec* iov) {{
+    if (!msg || !scratch || !iov) return 0;
+{field_lengths(message)}
+    /* Fixed-size fields accumulate in scratch until a string interrupts them */
+    int count = 0;
+    char* run = scratch;
+    char* p = scratch;
+    proto_put_u32(p, {name}_TAG);
+    p += 4;
+'''
+    for field in message['fields']:
+        fname = field['name']
+        if field['type'] == 'string':
+            code += f'''    proto_put_u32(p, (uint32_t){fname}_len);
+    p += 4;
+    iov[count].iov_base = run;
+    iov[count].iov_len = (size_t)(p - run);
+    count++;
+    run = p;
+    if ({fname}_len) {{
+        iov[count].iov_base = (void*)msg->{fname};
+        iov[count].iov_len = {fname}_len;
+        count++;
+    }}
+'''
+        elif field['type'] == 'int':
+            code += f'''    proto_put_u32(p, (uint32_t)msg->{fname});
+    p += 4;
+'''
+    code += '''    if (p != run) {
+        iov[count].iov_base = run;
+        iov[count].iov_len = (size_t)(p - run);
+        count++;
+    }
+    return count;
+}
+'''
+    return code
 
 def generate_encoder(message, filename, header_name):
-    """Generate encoder implementation for a specific message"""
+    """Generate encoder implementation for a specific message: exact sizing,
+    encoding into caller memory, the malloc'd encode_X and the batch encoder"""
+    name = message['name']
+    binary = message['format'] == 'binary'
     code = f'''
 #include "{header_name}"
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-char* encode_{message["name"]}(const {message["name"]}* msg, size_t* out_len) {{
+size_t encoded_size_{name}(const {name}* msg) {{
+    if (!msg) return 0;
+{field_lengths(message)}    return {encoded_size(message)};
+}}
+
+size_t encode_{name}_into(const {name}* msg, char* buf, size_t cap) {{
+    if (!msg || !buf) return 0;
+{field_lengths(message)}    size_t size = {encoded_size(message)};
+    if (cap < size) return 0;
+
+    char* p = buf;
+{encode_fields(message)}    return size;
+}}
+'''
+    if binary:
+        code += generate_iov_encoder(message)
+    # Text encodings stay NUL-terminated for callers that print them
+    terminator = 0 if binary else 1
+    code += f'''
+char* encode_{name}(const {name}* msg, size_t* out_len) {{
     if (!msg || !out_len) return NULL;
-    
-    /* Simple encoding: just print fields separated by | */
-    char buffer[4096];
-    int written = snprintf(buffer, sizeof(buffer), "{message["name"]}|");
-    
+
+    size_t size = encoded_size_{name}(msg);
+    if (size == 0) return NULL;
+    char* result = (char*)malloc(size + {terminator});
+    if (!result) return NULL;
+    if (encode_{name}_into(msg, result, size) != size) {{
+        free(result);
+        return NULL;
+    }}
+'''
+    if not binary:
+        code += "    result[size] = '\\0';\n"
+    code += f'''    *out_len = size;
+    return result;
+}}
+
+size_t encoded_batch_size_{name}(const {name}* msgs, size_t count) {{
+    if (!msgs) return 0;
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {{
+        size_t n = encoded_size_{name}(&msgs[i]);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        size += 4 + n;
+    }}
+    return size;
+}}
+
+size_t encode_{name}_batch(const {name}* msgs, size_t count, char* arena, size_t cap) {{
+    if (!msgs || !arena) return 0;
+    char* p = arena;
+    size_t left = cap;
+    for (size_t i = 0; i < count; i++) {{
+        if (left < 4) return 0;
+        size_t n = encode_{name}_into(&msgs[i], p + 4, left - 4);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        proto_put_u32(p, (uint32_t)n);
+        p += 4 + n;
+        left -= 4 + n;
+    }}
+    return (size_t)(p - arena);
+}}
+'''
+    return code
+
+def generate_text_view_decoder(message):
+    """Parse '|'-separated text in place: every field must be present and
+    terminated by '|', as encode_X writes it, though it may be empty"""
+    name = message['name']
+    code = f'''int decode_{name}_view(const char* data, size_t len, {name}_view* view) {{
+    static const char prefix[] = "{name}|";
+    if (!data || !view) return 0;
+    if (len < sizeof(prefix) - 1 || memcmp(data, prefix, sizeof(prefix) - 1) != 0) return 0;
+
+    const char* p = data + sizeof(prefix) - 1;
+    const char* end = data + len;
+    const char* sep;
+'''
+    for i, field in enumerate(message['fields']):
+        fname = field['name']
+        last = i == len(message['fields']) - 1
+        code += f'''
+    sep = (const char*)memchr(p, '|', (size_t)(end - p));
+    if (!sep) return 0;
+'''
+        if field['type'] == 'string':
+            code += f'''    view->{fname} = p;
+    view->{fname}_len = (size_t)(sep - p);
+'''
+        elif field['type'] == 'int':
+            code += f'''    if (!proto_parse_int(p, (size_t)(sep - p), &view->{fname})) return 0;
+'''
+        if not last:
+            code += '    p = sep + 1;\n'
+    code += '''
+    return 1;
+}
+'''
+    return code
+
+def generate_binary_view_decoder(message):
+    """Walk the binary fields in place, checking every length against the buffer"""
+    name = message['name']
+    code = f'''int decode_{name}_view(const char* data, size_t len, {name}_view* view) {{
+    if (!data || !view || len < 4 || proto_get_u32(data) != {name}_TAG) return 0;
+
+    const char* p = data + 4;
+    const char* end = data + len;
 '''
-    
     for field in message['fields']:
+        fname = field['name']
         if field['type'] == 'string':
-            code += f'    written += snprintf(buffer + written, sizeof(buffer) - written, "%s|", msg->{field["name"]} ? msg->{field["name"]} : "");\n'
+            code += f'''
+    if (end - p < 4) return 0;
+    view->{fname}_len = proto_get_u32(p);
+    p += 4;
+    if ((size_t)(end - p) < view->{fname}_len) return 0;
+    view->{fname} = p;
+    p += view->{fname}_len;
+'''
         elif field['type'] == 'int':
-            code += f'    written += snprintf(buffer + written, sizeof(buffer) - written, "%d|", msg->{field["name"]});\n'
-    
+            code += f'''
+    if (end - p < 4) return 0;
+    view->{fname} = (int)proto_get_u32(p);
+    p += 4;
+'''
     code += '''
-    *out_len = written;
-    char* result = (char*)malloc(written + 1);
-    if (result) {
-        memcpy(result, buffer, written);
-        result[written] = '\\0';
-    }
-    return result;
+    return 1;
 }
 '''
     return code
 
 def generate_decoder(message, filename, header_name):
-    """Generate decoder implementation for a specific message"""
+    """Generate decoder implementation for a specific message: the
+    allocation-free view decoder, and decode_X copying out of a view"""
+    name = message['name']
     code = f'''
 #include "{header_name}"
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-{message["name"]}* decode_{message["name"]}(const char* data, size_t len) {{
-    if (!data || len == 0) return NULL;
-    
-    {message["name"]}* msg = ({message["name"]}*)malloc(sizeof({message["name"]}));
+'''
+    if message['format'] == 'binary':
+        code += generate_binary_view_decoder(message)
+    else:
+        code += generate_text_view_decoder(message)
+    code += f'''
+{name}* decode_{name}(const char* data, size_t len) {{
+    {name}_view view;
+    if (!decode_{name}_view(data, len, &view)) return NULL;
+
+    {name}* msg = ({name}*)calloc(1, sizeof({name}));
     if (!msg) return NULL;
-    
-    /* Simple parsing - split by | */
-    char* copy = strndup(data, len);
-    if (!copy) {{
-        free(msg);
+'''
+    for field in message['fields']:
+        fname = field['name']
+        if field['type'] == 'string':
+            code += f'''    msg->{fname} = proto_strndup(view.{fname}, view.{fname}_len);
+    if (!msg->{fname}) {{
+        free_{name}(msg);
         return NULL;
     }}
-    
-    char* token = strtok(copy, "|");
-    if (!token || strcmp(token, "{message["name"]}") != 0) {{
-        free(copy);
-        free(msg);
-        return NULL;
+'''
+            if message['format'] == 'binary':
+                code += f'    msg->{fname}_len = view.{fname}_len;\n'
+        elif field['type'] == 'int':
+            code += f'    msg->{fname} = view.{fname};\n'
+    code += f'''    return msg;
+}}
+
+int decode_{name}_batch(const char* data, size_t len, {name}_view* views, size_t max_count,
+{' ' * len(f'int decode_{name}_batch(')}size_t* count, size_t* used) {{
+    if (!data || !views || !count || !used) return 0;
+    size_t n = 0;
+    size_t offset = 0;
+    int ok = 1;
+    while (n < max_count && len - offset >= 4) {{
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        if (!decode_{name}_view(data + offset + 4, frame, &views[n])) {{
+            ok = 0;
+            break;
+        }}
+        offset += 4 + frame;
+        n++;
     }}
-    
+    *count = n;
+    *used = offset;
+    return ok;
+}}
+
+/* Fills msg from a decoded view with strings copied into the arena */
+static void fill_{name}_from_view({name}* msg, const {name}_view* view, arena* a) {{
 '''
-    
     for field in message['fields']:
-        code += f'    token = strtok(NULL, "|");\n'
+        fname = field['name']
         if field['type'] == 'string':
-            code += f'    msg->{field["name"]} = token ? strdup(token) : NULL;\n'
+            code += f'    msg->{fname} = arena_strndup(a, view->{fname}, view->{fname}_len);\n'
+            if message['format'] == 'binary':
+                code += f'    msg->{fname}_len = view->{fname}_len;\n'
         elif field['type'] == 'int':
-            code += f'    msg->{field["name"]} = token ? atoi(token) : 0;\n'
-        code += '\n'
-    
-    code += '''    free(copy);
+            code += f'    msg->{fname} = view->{fname};\n'
+    code += f'''}}
+
+{name}* decode_{name}_arena(const char* data, size_t len, arena* a) {{
+    if (!a) return decode_{name}(data, len);
+    {name}_view view;
+    if (!decode_{name}_view(data, len, &view)) return NULL;
+
+    {name}* msg = ({name}*)arena_alloc(a, sizeof({name}));
+    fill_{name}_from_view(msg, &view, a);
     return msg;
-}
+}}
+
+int decode_{name}_batch_arena(const char* data, size_t len, arena* a, {name}** msgs,
+{' ' * len(f'int decode_{name}_batch_arena(')}size_t* count, size_t* used) {{
+    if (!data || !a || !msgs || !count || !used) return 0;
+
+    /* The frame lengths give the count without touching message contents */
+    size_t frames = 0;
+    size_t offset = 0;
+    while (len - offset >= 4) {{
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        offset += 4 + frame;
+        frames++;
+    }}
+
+    {name}* out = ({name}*)arena_alloc(a, (frames ? frames : 1) * sizeof({name}));
+    size_t n = 0;
+    int ok = 1;
+    offset = 0;
+    while (n < frames) {{
+        size_t frame = proto_get_u32(data + offset);
+        {name}_view view;
+        if (!decode_{name}_view(data + offset + 4, frame, &view)) {{
+            ok = 0;
+            break;
+        }}
+        fill_{name}_from_view(&out[n], &view, a);
+        offset += 4 + frame;
+        n++;
+    }}
+    *msgs = out;
+    *count = n;
+    *used = offset;
+    return ok;
+}}
 '''
     return code
 
@@ -178,13 +702,263 @@ void free_{message["name"]}({message["name"]}* msg) {{
 '''
     return code
 
+BENCH_TEMPLATE = '''
+/* Fuzz and throughput harness for @NAME@, generated from protocol.spec.
+   Round-trips random messages (empty strings, strings over 4 KB, '|' in text
+   strings, any byte in binary ones) through encode_@NAME@/decode_@NAME@ and
+   the view, checks they come back equal and that damaged input is refused
+   or decoded without harm, then times the codec.
+   Usage: bench_@NAME@ [messages] [seed] */
+
+#include "@HEADER@"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t rng_state = 1;
+
+/* xorshift64*: the same seed gives the same messages on every platform */
+static uint64_t next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 2685821657736338717ULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void* checked_malloc(size_t size) {
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        fprintf(stderr, "Error: Memory allocation failed\\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+@INT_HELPER@/* Empty, short, medium or over 4 KB.  Text strings are printable and one in
+   eight holds a '|'; binary strings take any byte. */
+static char* random_string_field(size_t* len, int binary) {
+    size_t n;
+    switch (next_random() % 4) {
+    case 0: n = 0; break;
+    case 1: n = 1 + next_random() % 16; break;
+    case 2: n = 17 + next_random() % 240; break;
+    default: n = 4097 + next_random() % 12288; break;
+    }
+    char* s = (char*)checked_malloc(n + 1);
+    for (size_t i = 0; i < n; i++) {
+        if (binary) {
+            s[i] = (char)next_random();
+        } else {
+            s[i] = (char)(' ' + next_random() % 92);
+            if (s[i] == '|') s[i] = '~';
+        }
+    }
+    if (!binary && n > 0 && next_random() % 8 == 0) s[next_random() % n] = '|';
+    s[n] = '\\0';
+    *len = n;
+    return s;
+}
+
+/* Returns 0 when the message cannot be encoded in its wire format */
+static int random_message(@NAME@* msg) {
+    int encodable = 1;
+    size_t len;
+@RANDOM@    (void)len;
+    return encodable;
+}
+
+static void free_random_message(@NAME@* msg) {
+@FREE@}
+
+static int same_message(const @NAME@* a, const @NAME@* b) {
+@SAME@    return 1;
+}
+
+static int same_view(const @NAME@* a, const @NAME@_view* b) {
+@SAME_VIEW@    return 1;
+}
+
+static void report(const char* what, double seconds, size_t messages, size_t bytes) {
+    printf("  %-24s %10.1f ns/message %10.1f MB/s\\n", what, seconds * 1e9 / messages, bytes / seconds / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+    if (argc > 2) rng_state = strtoull(argv[2], NULL, 10);
+    if (count == 0) count = 1;
+    if (rng_state == 0) rng_state = 1;
+
+    @NAME@* msgs = (@NAME@*)checked_malloc(count * sizeof(@NAME@));
+    size_t kept = 0;
+    size_t refused = 0;
+    size_t failures = 0;
+    for (size_t i = 0; i < count; i++) {
+        @NAME@* msg = &msgs[kept];
+        int encodable = random_message(msg);
+        size_t len;
+        char* data = encode_@NAME@(msg, &len);
+        if (!encodable) {
+            if (data) {
+                fprintf(stderr, "Error: message %zu was encoded though its format cannot carry it\\n", i);
+                failures++;
+            }
+            free(data);
+            free_random_message(msg);
+            refused++;
+            continue;
+        }
+        if (!data || len != encoded_size_@NAME@(msg)) {
+            fprintf(stderr, "Error: message %zu failed to encode\\n", i);
+            failures++;
+            free(data);
+            free_random_message(msg);
+            continue;
+        }
+
+        @NAME@* decoded = decode_@NAME@(data, len);
+        @NAME@_view view;
+        if (!decoded || !same_message(msg, decoded)) {
+            fprintf(stderr, "Error: message %zu did not round-trip through decode_@NAME@\\n", i);
+            failures++;
+        } else if (!decode_@NAME@_view(data, len, &view) || !same_view(msg, &view)) {
+            fprintf(stderr, "Error: message %zu did not round-trip through decode_@NAME@_view\\n", i);
+            failures++;
+        } else if (decode_@NAME@_view(data, len - 1, &view)) {
+            fprintf(stderr, "Error: message %zu was decoded from truncated input\\n", i);
+            failures++;
+        }
+        free_@NAME@(decoded);
+
+        /* Damaged input must be refused or decoded, never read out of bounds */
+        for (int flips = 1 + (int)(next_random() % 4); flips > 0; flips--) {
+            data[next_random() % len] ^= (char)(1 + next_random() % 255);
+        }
+        if (decode_@NAME@_view(data, len, &view)) {
+            free_@NAME@(decode_@NAME@(data, len));
+        }
+        free(data);
+        kept++;
+    }
+    if (failures) {
+        fprintf(stderr, "Error: %zu of %zu @NAME@ messages failed\\n", failures, count);
+        return 1;
+    }
+    printf("@NAME@: %zu messages round-tripped, %zu refused as unencodable\\n", kept, refused);
+    if (kept == 0) return 0;
+
+    /* Throughput over the encodable messages, repeated to about 64 MB */
+    size_t arena_size = encoded_batch_size_@NAME@(msgs, kept);
+    size_t bytes = arena_size - 4 * kept;
+    size_t reps = (64u << 20) / arena_size + 1;
+    char* arena_buf = (char*)checked_malloc(arena_size);
+    @NAME@_view* views = (@NAME@_view*)checked_malloc(kept * sizeof(@NAME@_view));
+    size_t sink = 0;
+
+    double start = now();
+    for (size_t r = 0; r < reps; r++) {
+        sink += encode_@NAME@_batch(msgs, kept, arena_buf, arena_size);
+    }
+    report("encode_@NAME@_batch", now() - start, kept * reps, bytes * reps);
+
+    start = now();
+    for (size_t r = 0; r < reps; r++) {
+        size_t decoded, used;
+        decode_@NAME@_batch(arena_buf, arena_size, views, kept, &decoded, &used);
+        sink += used;
+    }
+    report("decode_@NAME@_batch", now() - start, kept * reps, bytes * reps);
+
+    start = now();
+    for (size_t r = 0; r < reps; r++) {
+        for (size_t i = 0; i < kept; i++) {
+            size_t len;
+            char* data = encode_@NAME@(&msgs[i], &len);
+            @NAME@* decoded = decode_@NAME@(data, len);
+            sink += len;
+            free_@NAME@(decoded);
+            free(data);
+        }
+    }
+    report("encode+decode_@NAME@", now() - start, kept * reps, bytes * reps);
+
+    if (sink == 0) printf("\\n");
+    for (size_t i = 0; i < kept; i++) {
+        free_random_message(&msgs[i]);
+    }
+    free(views);
+    free(arena_buf);
+    free(msgs);
+    return 0;
+}
+'''
+
+BENCH_INT_HELPER = '''static int random_int_field(void) {
+    static const int edges[] = {0, 1, -1, INT_MAX, INT_MIN};
+    if (next_random() % 4 == 0) return edges[next_random() % 5];
+    return (int)(uint32_t)next_random();
+}
+
+'''
+
+def generate_bench(message, filename, header_name):
+    """Generate the fuzz and throughput harness for a specific message"""
+    binary = message['format'] == 'binary'
+    random_fields = ''
+    free_fields = ''
+    same = ''
+    same_view = ''
+    for field in message['fields']:
+        fname = field['name']
+        if field['type'] == 'string':
+            random_fields += f'    msg->{fname} = random_string_field(&len, {int(binary)});\n'
+            if binary:
+                random_fields += f'    msg->{fname}_len = len;\n'
+                a_len = f'proto_str_len(a->{fname}, a->{fname}_len)'
+                b_len = f'proto_str_len(b->{fname}, b->{fname}_len)'
+            else:
+                random_fields += f"    if (len && memchr(msg->{fname}, '|', len)) encodable = 0;\n"
+                a_len = f'strlen(a->{fname})'
+                b_len = f'strlen(b->{fname})'
+            free_fields += f'    free((void*)msg->{fname});\n'
+            same += f'    if ({a_len} != {b_len} || memcmp(a->{fname}, b->{fname}, {a_len}) != 0) return 0;\n'
+            same_view += f'    if ({a_len} != b->{fname}_len || memcmp(a->{fname}, b->{fname}, b->{fname}_len) != 0) return 0;\n'
+        elif field['type'] == 'int':
+            random_fields += f'    msg->{fname} = random_int_field();\n'
+            same += f'    if (a->{fname} != b->{fname}) return 0;\n'
+            same_view += f'    if (a->{fname} != b->{fname}) return 0;\n'
+    int_helper = BENCH_INT_HELPER if any(field['type'] == 'int' for field in message['fields']) else ''
+    code = BENCH_TEMPLATE
+    for key, value in (('@INT_HELPER@', int_helper), ('@RANDOM@', random_fields), ('@FREE@', free_fields), ('@SAME@', same),
+                       ('@SAME_VIEW@', same_view), ('@HEADER@', header_name), ('@NAME@', message['name'])):
+        code = code.replace(key, value)
+    return code
+
 def main():
-    if len(sys.argv) != 2:
-        print("Usage: python3 generate_protocol.py <integer>")
+    args = sys.argv[1:]
+    manifest_path = None
+    per_message = False
+    positional = []
+    while args:
+        arg = args.pop(0)
+        if arg == '--manifest' and args:
+            manifest_path = args.pop(0)
+        elif arg == '--per-message':
+            per_message = True
+        else:
+            positional.append(arg)
+    if len(positional) != 1:
+        print("Usage: python3 generate_protocol.py <integer> [--manifest <file>] [--per-message]")
         sys.exit(1)
     
     try:
-        integer_arg = int(sys.argv[1])
+        integer_arg = int(positional[0])
     except ValueError:
         print("Error: Argument must be an integer")
         sys.exit(1)
@@ -192,6 +966,10 @@ def main():
     # Parse protocol specification
     messages = parse_protocol_spec('protocol.spec')
     print(f"Parsed {len(messages)} messages from protocol.spec")
+    names = [msg['name'] for msg in messages]
+    if len(set(names)) != len(names):
+        print("Error: protocol.spec defines a message more than once")
+        sys.exit(1)
     
     # Generate MD5 hash from seed
     md5_hash = md5sum(integer_arg)
@@ -208,51 +986,86 @@ def main():
     
     print(f"Header name: {header_name}")
     
-    # Generate header file with dynamic name
-    header_content = generate_header(messages, header_guard)
-    with open(header_name, 'w') as f:
-        f.write(header_content)
-    print(f"Generated: {header_name}")
+    # Each message gets 3 files: encoder, decoder, free function.  By default
+    # they are named after single characters of the seed's MD5; with
+    # --per-message after a hash of each message's own name, with a header
+    # per message, so editing one message rewrites only its own files
+    roles = [('encode', generate_encoder), ('decode', generate_decoder), ('free', generate_free_function)]
+    files = []
+    headers = []
+    if per_message:
+        ids = message_ids(messages, integer_arg)
+        common_header = f"proto_{md5_hash[:8]}_common.h"
+        headers.append((common_header, wrap_header(f"PROTO_{md5_hash[:8].upper()}_COMMON_H", header_prologue())))
+        message_headers = []
+        for message in messages:
+            message_id = ids[message['name']]
+            message_header = f"proto_{message_id}.h"
+            message_headers.append(message_header)
+            headers.append((message_header, generate_message_header(message, f"PROTO_{message_id.upper()}_H",
+                                                                    common_header)))
+            for role, generate in roles:
+                files.append((message, f"proto_{message_id}_{role}.c", generate, message_header))
+        headers.insert(0, (header_name, generate_umbrella_header(header_guard, message_headers)))
+    else:
+        headers.append((header_name, generate_header(messages, header_guard)))
+        for i, message in enumerate(messages):
+            # Use different parts of MD5 hash for each file
+            hash_idx = (i * 3) % len(md5_hash)
+            for offset, (role, generate) in enumerate(roles):
+                file_hash = md5_hash[(hash_idx + offset) % len(md5_hash)]
+                files.append((message, f"proto_{file_hash}_{role}.c", generate, header_name))
+    
+    # Two files with one name would silently overwrite each other
+    owners = {}
+    for message, filename, generate, include in files:
+        owners.setdefault(filename, []).append(message['name'])
+    clashes = sorted(filename for filename, owner in owners.items() if len(owner) > 1)
+    if clashes:
+        for filename in clashes:
+            print(f"Error: {filename} would be generated for {' and '.join(owners[filename])}")
+        print("Error: Use --per-message for collision-free file names")
+        sys.exit(1)
+    
+    # Generate the headers, then the implementation files
+    generated_headers = []
+    for path, content in headers:
+        emit(path, content, generated_headers)
     
-    # Create proto_impl directory
     create_proto_impl_dir()
+    generated = []
+    sources_of = {}
+    for message, filename, generate, include in files:
+        path = os.path.join('proto_impl', filename)
+        emit(path, generate(message, filename, include), generated)
+        sources_of.setdefault(message['name'], []).append(path)
     
-    # Generate implementation files with unpredictable names based on MD5
-    # Each message gets 3 files: encoder, decoder, free function
-    file_count = 0
-    for i, message in enumerate(messages):
-        # Use different parts of MD5 hash for each file
-        hash_idx = (i * 3) % len(md5_hash)
-        
-        # Encoder file
-        encoder_hash = md5_hash[hash_idx]
-        encoder_filename = f"proto_{encoder_hash}_encode.c"
-        encoder_path = os.path.join('proto_impl', encoder_filename)
-        with open(encoder_path, 'w') as f:
-            f.write(generate_encoder(message, encoder_filename, header_name))
-        print(f"Generated: {encoder_path}")
-        file_count += 1
-        
-        # Decoder file
-        decoder_hash = md5_hash[(hash_idx + 1) % len(md5_hash)]
-        decoder_filename = f"proto_{decoder_hash}_decode.c"
-        decoder_path = os.path.join('proto_impl', decoder_filename)
-        with open(decoder_path, 'w') as f:
-            f.write(generate_decoder(message, decoder_filename, header_name))
-        print(f"Generated: {decoder_path}")
-        file_count += 1
-        
-        # Free function file
-        free_hash = md5_hash[(hash_idx + 2) % len(md5_hash)]
-        free_filename = f"proto_{free_hash}_free.c"
-        free_path = os.path.join('proto_impl', free_filename)
-        with open(free_path, 'w') as f:
-            f.write(generate_free_function(message, free_filename, header_name))
-        print(f"Generated: {free_path}")
-        file_count += 1
+    # One fuzz and throughput harness per message, outside the library
+    if not os.path.exists('proto_bench'):
+        os.makedirs('proto_bench')
+    benches = []
+    for message, filename, generate, include in files:
+        if filename.endswith('_encode.c'):
+            bench_filename = f"bench_{message['name']}.c"
+            emit(os.path.join('proto_bench', bench_filename), generate_bench(message, bench_filename, include),
+                 benches)
     
-    print(f"Total files generated: {file_count + 1} ({file_count} .c files + 1 .h file)")
+    print(f"Total files generated: {len(generated) + len(benches) + len(generated_headers)} "
+          f"({len(generated) + len(benches)} .c files + {len(generated_headers)} .h files)")
     print(f"HEADER_FILE={header_name}")
+    
+    if manifest_path:
+        for stale in sorted(read_manifest(manifest_path) - set(generated + benches + generated_headers)):
+            if os.path.exists(stale):
+                os.remove(stale)
+                print(f"Removed: {stale}")
+        variables = [('GENERATED_HEADER', [header_name]),
+                     ('GENERATED_HEADERS', sorted(generated_headers)),
+                     ('GENERATED_SOURCES', sorted(set(generated))),
+                     ('GENERATED_BENCHES', sorted(benches))]
+        variables += [(f'MESSAGE_{msg["name"]}_SOURCES', sources_of[msg['name']]) for msg in messages]
+        write_manifest(manifest_path, variables)
+        print(f"Manifest: {manifest_path}")
 
 if __name__ == "__main__":
     main()
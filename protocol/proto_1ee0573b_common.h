@@ -0,0 +1,110 @@
+
+#ifndef PROTO_1EE0573B_COMMON_H
+#define PROTO_1EE0573B_COMMON_H
+
+#include <stddef.h>
+#include "utils.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+/* 32-bit little-endian words, used by the binary format and batch frames */
+static inline void proto_put_u32(char* p, uint32_t value) {
+    unsigned char* b = (unsigned char*)p;
+    b[0] = (unsigned char)value;
+    b[1] = (unsigned char)(value >> 8);
+    b[2] = (unsigned char)(value >> 16);
+    b[3] = (unsigned char)(value >> 24);
+}
+
+static inline uint32_t proto_get_u32(const char* p) {
+    const unsigned char* b = (const unsigned char*)p;
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+/* Decoder helpers: a bounded decimal int parse (no NUL terminator needed)
+   and a NUL-terminated copy of a field */
+static inline int proto_parse_int(const char* s, size_t len, int* out) {
+    size_t i = 0;
+    int negative = 0;
+    unsigned long value = 0;
+    if (len > 0 && (s[0] == '-' || s[0] == '+')) {
+        negative = s[0] == '-';
+        i = 1;
+    }
+    if (i == len) return 0;
+    for (; i < len; i++) {
+        if (s[i] < '0' || s[i] > '9') return 0;
+        value = value * 10 + (unsigned long)(s[i] - '0');
+        if (value > (unsigned long)INT_MAX + 1) return 0;
+    }
+    if (!negative && value > (unsigned long)INT_MAX) return 0;
+    *out = negative ? (int)(0 - (long)value) : (int)value;
+    return 1;
+}
+
+static inline char* proto_strndup(const char* s, size_t len) {
+    char* copy = (char*)malloc(len + 1);
+    if (!copy) return NULL;
+    if (len) memcpy(copy, s, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+/* Text encoder helpers: the length of an int in decimal, and writing it */
+static inline size_t proto_int_len(int value) {
+    unsigned int u = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    size_t len = value < 0 ? 2 : 1;
+    while (u >= 10) {
+        u /= 10;
+        len++;
+    }
+    return len;
+}
+
+static inline size_t proto_put_int(char* p, int value) {
+    unsigned int u = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    size_t len = proto_int_len(value);
+    char* q = p + len;
+    do {
+        *--q = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0) *p = '-';
+    return len;
+}
+
+/* Binary wire format: a 32-bit type tag, then every field in spec order;
+   ints are 32-bit little-endian, strings a 32-bit length and their bytes.
+   A string field's length is its _len member, or strlen when that is 0 */
+static inline size_t proto_str_len(const char* s, size_t len) {
+    return len ? len : (s ? strlen(s) : 0);
+}
+
+/* Every message X gets:
+   - X, owning its strings, and X_view, filled in place by decode_X_view with
+     pointer+length views into the encoded buffer (not NUL-terminated)
+   - encode_X, returning a malloc'd encoding, and decode_X/free_X
+   - encoded_size_X, the exact encoded size (0 if it cannot be encoded: a
+     text string containing '|', or a binary one over 4 GB), and
+     encode_X_into, writing it to buf and returning it (0 if cap is too small)
+   - batches: runs of frames, each a 32-bit little-endian length and one
+     encoded message.  encode_X_batch writes count messages to the arena and
+     returns the bytes used (0 if they do not fit), encoded_batch_size_X is
+     that size up front.  decode_X_batch fills up to max_count views from
+     whole frames, leaving a trailing partial frame for the next call; it
+     returns 0 on a malformed frame, with count and used covering the frames
+     before it
+   - decode_X_arena, decoding like decode_X but taking the struct and its
+     strings from the arena (from the heap, as decode_X, when it is NULL);
+     such a message must not be passed to free_X.  decode_X_batch_arena
+     decodes every whole frame of a batch into one array in the arena, with
+     the same count, used and return value as decode_X_batch
+   Binary messages also get encode_X_iov, filling at most X_IOV_MAX iovecs
+   with fixed-size fields taken from scratch (X_SCRATCH_SIZE bytes) and
+   strings in place */
+
+
+#endif /* PROTO_1EE0573B_COMMON_H */
@@ -0,0 +1,43 @@
+
+#ifndef PROTO_20A5E7A9_H
+#define PROTO_20A5E7A9_H
+
+#include "proto_1ee0573b_common.h"
+
+/* DataPacket message structure */
+typedef struct {
+    int id;
+    const char* payload;
+    size_t payload_len;
+    int size;
+} DataPacket;
+
+/* DataPacket view into an encoded message */
+typedef struct {
+    int id;
+    const char* payload;
+    size_t payload_len;
+    int size;
+} DataPacket_view;
+
+char* encode_DataPacket(const DataPacket* msg, size_t* out_len);
+DataPacket* decode_DataPacket(const char* data, size_t len);
+void free_DataPacket(DataPacket* msg);
+int decode_DataPacket_view(const char* data, size_t len, DataPacket_view* view);
+size_t encoded_size_DataPacket(const DataPacket* msg);
+size_t encode_DataPacket_into(const DataPacket* msg, char* buf, size_t cap);
+size_t encoded_batch_size_DataPacket(const DataPacket* msgs, size_t count);
+size_t encode_DataPacket_batch(const DataPacket* msgs, size_t count, char* arena, size_t cap);
+int decode_DataPacket_batch(const char* data, size_t len, DataPacket_view* views, size_t max_count,
+                            size_t* count, size_t* used);
+DataPacket* decode_DataPacket_arena(const char* data, size_t len, arena* a);
+int decode_DataPacket_batch_arena(const char* data, size_t len, arena* a, DataPacket** msgs,
+                                  size_t* count, size_t* used);
+
+#define DataPacket_TAG 0xfe58798du
+#define DataPacket_IOV_MAX 3
+#define DataPacket_SCRATCH_SIZE 16
+int encode_DataPacket_iov(const DataPacket* msg, char* scratch, struct iovec* iov);
+
+
+#endif /* PROTO_20A5E7A9_H */
@@ -0,0 +1,36 @@
+
+#ifndef PROTO_5D2F46E3_H
+#define PROTO_5D2F46E3_H
+
+#include "proto_1ee0573b_common.h"
+
+/* LoginRequest message structure */
+typedef struct {
+    const char* username;
+    const char* password;
+} LoginRequest;
+
+/* LoginRequest view into an encoded message */
+typedef struct {
+    const char* username;
+    size_t username_len;
+    const char* password;
+    size_t password_len;
+} LoginRequest_view;
+
+char* encode_LoginRequest(const LoginRequest* msg, size_t* out_len);
+LoginRequest* decode_LoginRequest(const char* data, size_t len);
+void free_LoginRequest(LoginRequest* msg);
+int decode_LoginRequest_view(const char* data, size_t len, LoginRequest_view* view);
+size_t encoded_size_LoginRequest(const LoginRequest* msg);
+size_t encode_LoginRequest_into(const LoginRequest* msg, char* buf, size_t cap);
+size_t encoded_batch_size_LoginRequest(const LoginRequest* msgs, size_t count);
+size_t encode_LoginRequest_batch(const LoginRequest* msgs, size_t count, char* arena, size_t cap);
+int decode_LoginRequest_batch(const char* data, size_t len, LoginRequest_view* views, size_t max_count,
+                              size_t* count, size_t* used);
+LoginRequest* decode_LoginRequest_arena(const char* data, size_t len, arena* a);
+int decode_LoginRequest_batch_arena(const char* data, size_t len, arena* a, LoginRequest** msgs,
+                                    size_t* count, size_t* used);
+
+
+#endif /* PROTO_5D2F46E3_H */
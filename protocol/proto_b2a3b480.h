@@ -0,0 +1,35 @@
+
+#ifndef PROTO_B2A3B480_H
+#define PROTO_B2A3B480_H
+
+#include "proto_1ee0573b_common.h"
+
+/* StatusUpdate message structure */
+typedef struct {
+    int code;
+    const char* message;
+} StatusUpdate;
+
+/* StatusUpdate view into an encoded message */
+typedef struct {
+    int code;
+    const char* message;
+    size_t message_len;
+} StatusUpdate_view;
+
+char* encode_StatusUpdate(const StatusUpdate* msg, size_t* out_len);
+StatusUpdate* decode_StatusUpdate(const char* data, size_t len);
+void free_StatusUpdate(StatusUpdate* msg);
+int decode_StatusUpdate_view(const char* data, size_t len, StatusUpdate_view* view);
+size_t encoded_size_StatusUpdate(const StatusUpdate* msg);
+size_t encode_StatusUpdate_into(const StatusUpdate* msg, char* buf, size_t cap);
+size_t encoded_batch_size_StatusUpdate(const StatusUpdate* msgs, size_t count);
+size_t encode_StatusUpdate_batch(const StatusUpdate* msgs, size_t count, char* arena, size_t cap);
+int decode_StatusUpdate_batch(const char* data, size_t len, StatusUpdate_view* views, size_t max_count,
+                              size_t* count, size_t* used);
+StatusUpdate* decode_StatusUpdate_arena(const char* data, size_t len, arena* a);
+int decode_StatusUpdate_batch_arena(const char* data, size_t len, arena* a, StatusUpdate** msgs,
+                                    size_t* count, size_t* used);
+
+
+#endif /* PROTO_B2A3B480_H */
@@ -0,0 +1,209 @@
+
+/* Fuzz and throughput harness for StatusUpdate, generated from protocol.spec.
+   Round-trips random messages (empty strings, strings over 4 KB, '|' in text
+   strings, any byte in binary ones) through encode_StatusUpdate/decode_StatusUpdate and
+   the view, checks they come back equal and that damaged input is refused
+   or decoded without harm, then times the codec.
+   Usage: bench_StatusUpdate [messages] [seed] */
+
+#include "proto_b2a3b480.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t rng_state = 1;
+
+/* xorshift64*: the same seed gives the same messages on every platform */
+static uint64_t next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 2685821657736338717ULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void* checked_malloc(size_t size) {
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+static int random_int_field(void) {
+    static const int edges[] = {0, 1, -1, INT_MAX, INT_MIN};
+    if (next_random() % 4 == 0) return edges[next_random() % 5];
+    return (int)(uint32_t)next_random();
+}
+
+/* Empty, short, medium or over 4 KB.  Text strings are printable and one in
+   eight holds a '|'; binary strings take any byte. */
+static char* random_string_field(size_t* len, int binary) {
+    size_t n;
+    switch (next_random() % 4) {
+    case 0: n = 0; break;
+    case 1: n = 1 + next_random() % 16; break;
+    case 2: n = 17 + next_random() % 240; break;
+    default: n = 4097 + next_random() % 12288; break;
+    }
+    char* s = (char*)checked_malloc(n + 1);
+    for (size_t i = 0; i < n; i++) {
+        if (binary) {
+            s[i] = (char)next_random();
+        } else {
+            s[i] = (char)(' ' + next_random() % 92);
+            if (s[i] == '|') s[i] = '~';
+        }
+    }
+    if (!binary && n > 0 && next_random() % 8 == 0) s[next_random() % n] = '|';
+    s[n] = '\0';
+    *len = n;
+    return s;
+}
+
+/* Returns 0 when the message cannot be encoded in its wire format */
+static int random_message(StatusUpdate* msg) {
+    int encodable = 1;
+    size_t len;
+    msg->code = random_int_field();
+    msg->message = random_string_field(&len, 0);
+    if (len && memchr(msg->message, '|', len)) encodable = 0;
+    (void)len;
+    return encodable;
+}
+
+static void free_random_message(StatusUpdate* msg) {
+    free((void*)msg->message);
+}
+
+static int same_message(const StatusUpdate* a, const StatusUpdate* b) {
+    if (a->code != b->code) return 0;
+    if (strlen(a->message) != strlen(b->message) || memcmp(a->message, b->message, strlen(a->message)) != 0) return 0;
+    return 1;
+}
+
+static int same_view(const StatusUpdate* a, const StatusUpdate_view* b) {
+    if (a->code != b->code) return 0;
+    if (strlen(a->message) != b->message_len || memcmp(a->message, b->message, b->message_len) != 0) return 0;
+    return 1;
+}
+
+static void report(const char* what, double seconds, size_t messages, size_t bytes) {
+    printf("  %-24s %10.1f ns/message %10.1f MB/s\n", what, seconds * 1e9 / messages, bytes / seconds / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+    if (argc > 2) rng_state = strtoull(argv[2], NULL, 10);
+    if (count == 0) count = 1;
+    if (rng_state == 0) rng_state = 1;
+
+    StatusUpdate* msgs = (StatusUpdate*)checked_malloc(count * sizeof(StatusUpdate));
+    size_t kept = 0;
+    size_t refused = 0;
+    size_t failures = 0;
+    for (size_t i = 0; i < count; i++) {
+        StatusUpdate* msg = &msgs[kept];
+        int encodable = random_message(msg);
+        size_t len;
+        char* data = encode_StatusUpdate(msg, &len);
+        if (!encodable) {
+            if (data) {
+                fprintf(stderr, "Error: message %zu was encoded though its format cannot carry it\n", i);
+                failures++;
+            }
+            free(data);
+            free_random_message(msg);
+            refused++;
+            continue;
+        }
+        if (!data || len != encoded_size_StatusUpdate(msg)) {
+            fprintf(stderr, "Error: message %zu failed to encode\n", i);
+            failures++;
+            free(data);
+            free_random_message(msg);
+            continue;
+        }
+
+        StatusUpdate* decoded = decode_StatusUpdate(data, len);
+        StatusUpdate_view view;
+        if (!decoded || !same_message(msg, decoded)) {
+            fprintf(stderr, "Error: message %zu did not round-trip through decode_StatusUpdate\n", i);
+            failures++;
+        } else if (!decode_StatusUpdate_view(data, len, &view) || !same_view(msg, &view)) {
+            fprintf(stderr, "Error: message %zu did not round-trip through decode_StatusUpdate_view\n", i);
+            failures++;
+        } else if (decode_StatusUpdate_view(data, len - 1, &view)) {
+            fprintf(stderr, "Error: message %zu was decoded from truncated input\n", i);
+            failures++;
+        }
+        free_StatusUpdate(decoded);
+
+        /* Damaged input must be refused or decoded, never read out of bounds */
+        for (int flips = 1 + (int)(next_random() % 4); flips > 0; flips--) {
+            data[next_random() % len] ^= (char)(1 + next_random() % 255);
+        }
+        if (decode_StatusUpdate_view(data, len, &view)) {
+            free_StatusUpdate(decode_StatusUpdate(data, len));
+        }
+        free(data);
+        kept++;
+    }
+    if (failures) {
+        fprintf(stderr, "Error: %zu of %zu StatusUpdate messages failed\n", failures, count);
+        return 1;
+    }
+    printf("StatusUpdate: %zu messages round-tripped, %zu refused as unencodable\n", kept, refused);
+    if (kept == 0) return 0;
+
+    /* Throughput over the encodable messages, repeated to about 64 MB */
+    size_t arena_size = encoded_batch_size_StatusUpdate(msgs, kept);
+    size_t bytes = arena_size - 4 * kept;
+    size_t reps = (64u << 20) / arena_size + 1;
+    char* arena_buf = (char*)checked_malloc(arena_size);
+    StatusUpdate_view* views = (StatusUpdate_view*)checked_malloc(kept * sizeof(StatusUpdate_view));
+    size_t sink = 0;
+
+    double start = now();
+    for (size_t r = 0; r < reps; r++) {
+        sink += encode_StatusUpdate_batch(msgs, kept, arena_buf, arena_size);
+    }
+    report("encode_StatusUpdate_batch", now() - start, kept * reps, bytes * reps);
+
+    start = now();
+    for (size_t r = 0; r < reps; r++) {
+        size_t decoded, used;
+        decode_StatusUpdate_batch(arena_buf, arena_size, views, kept, &decoded, &used);
+        sink += used;
+    }
+    report("decode_StatusUpdate_batch", now() - start, kept * reps, bytes * reps);
+
+    start = now();
+    for (size_t r = 0; r < reps; r++) {
+        for (size_t i = 0; i < kept; i++) {
+            size_t len;
+            char* data = encode_StatusUpdate(&msgs[i], &len);
+            StatusUpdate* decoded = decode_StatusUpdate(data, len);
+            sink += len;
+            free_StatusUpdate(decoded);
+            free(data);
+        }
+    }
+    report("encode+decode_StatusUpdate", now() - start, kept * reps, bytes * reps);
+
+    if (sink == 0) printf("\n");
+    for (size_t i = 0; i < kept; i++) {
+        free_random_message(&msgs[i]);
+    }
+    free(views);
+    free(arena_buf);
+    free(msgs);
+    return 0;
+}
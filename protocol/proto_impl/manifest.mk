@@ -0,0 +1,8 @@
+# Generated by generate_protocol.py, do not edit
+GENERATED_HEADER = protocol_3b359798.h
+GENERATED_HEADERS = proto_1ee0573b_common.h proto_20a5e7a9.h proto_5d2f46e3.h proto_b2a3b480.h protocol_3b359798.h
+GENERATED_SOURCES = proto_impl/proto_20a5e7a9_decode.c proto_impl/proto_20a5e7a9_encode.c proto_impl/proto_20a5e7a9_free.c proto_impl/proto_5d2f46e3_decode.c proto_impl/proto_5d2f46e3_encode.c proto_impl/proto_5d2f46e3_free.c proto_impl/proto_b2a3b480_decode.c proto_impl/proto_b2a3b480_encode.c proto_impl/proto_b2a3b480_free.c
+GENERATED_BENCHES = proto_bench/bench_DataPacket.c proto_bench/bench_LoginRequest.c proto_bench/bench_StatusUpdate.c
+MESSAGE_LoginRequest_SOURCES = proto_impl/proto_5d2f46e3_encode.c proto_impl/proto_5d2f46e3_decode.c proto_impl/proto_5d2f46e3_free.c
+MESSAGE_StatusUpdate_SOURCES = proto_impl/proto_b2a3b480_encode.c proto_impl/proto_b2a3b480_decode.c proto_impl/proto_b2a3b480_free.c
+MESSAGE_DataPacket_SOURCES = proto_impl/proto_20a5e7a9_encode.c proto_impl/proto_20a5e7a9_decode.c proto_impl/proto_20a5e7a9_free.c
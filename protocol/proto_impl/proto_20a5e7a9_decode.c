@@ -0,0 +1,119 @@
+
+#include "proto_20a5e7a9.h"
+#include <stdlib.h>
+#include <string.h>
+
+int decode_DataPacket_view(const char* data, size_t len, DataPacket_view* view) {
+    if (!data || !view || len < 4 || proto_get_u32(data) != DataPacket_TAG) return 0;
+
+    const char* p = data + 4;
+    const char* end = data + len;
+
+    if (end - p < 4) return 0;
+    view->id = (int)proto_get_u32(p);
+    p += 4;
+
+    if (end - p < 4) return 0;
+    view->payload_len = proto_get_u32(p);
+    p += 4;
+    if ((size_t)(end - p) < view->payload_len) return 0;
+    view->payload = p;
+    p += view->payload_len;
+
+    if (end - p < 4) return 0;
+    view->size = (int)proto_get_u32(p);
+    p += 4;
+
+    return 1;
+}
+
+DataPacket* decode_DataPacket(const char* data, size_t len) {
+    DataPacket_view view;
+    if (!decode_DataPacket_view(data, len, &view)) return NULL;
+
+    DataPacket* msg = (DataPacket*)calloc(1, sizeof(DataPacket));
+    if (!msg) return NULL;
+    msg->id = view.id;
+    msg->payload = proto_strndup(view.payload, view.payload_len);
+    if (!msg->payload) {
+        free_DataPacket(msg);
+        return NULL;
+    }
+    msg->payload_len = view.payload_len;
+    msg->size = view.size;
+    return msg;
+}
+
+int decode_DataPacket_batch(const char* data, size_t len, DataPacket_view* views, size_t max_count,
+                            size_t* count, size_t* used) {
+    if (!data || !views || !count || !used) return 0;
+    size_t n = 0;
+    size_t offset = 0;
+    int ok = 1;
+    while (n < max_count && len - offset >= 4) {
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        if (!decode_DataPacket_view(data + offset + 4, frame, &views[n])) {
+            ok = 0;
+            break;
+        }
+        offset += 4 + frame;
+        n++;
+    }
+    *count = n;
+    *used = offset;
+    return ok;
+}
+
+/* Fills msg from a decoded view with strings copied into the arena */
+static void fill_DataPacket_from_view(DataPacket* msg, const DataPacket_view* view, arena* a) {
+    msg->id = view->id;
+    msg->payload = arena_strndup(a, view->payload, view->payload_len);
+    msg->payload_len = view->payload_len;
+    msg->size = view->size;
+}
+
+DataPacket* decode_DataPacket_arena(const char* data, size_t len, arena* a) {
+    if (!a) return decode_DataPacket(data, len);
+    DataPacket_view view;
+    if (!decode_DataPacket_view(data, len, &view)) return NULL;
+
+    DataPacket* msg = (DataPacket*)arena_alloc(a, sizeof(DataPacket));
+    fill_DataPacket_from_view(msg, &view, a);
+    return msg;
+}
+
+int decode_DataPacket_batch_arena(const char* data, size_t len, arena* a, DataPacket** msgs,
+                                  size_t* count, size_t* used) {
+    if (!data || !a || !msgs || !count || !used) return 0;
+
+    /* The frame lengths give the count without touching message contents */
+    size_t frames = 0;
+    size_t offset = 0;
+    while (len - offset >= 4) {
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        offset += 4 + frame;
+        frames++;
+    }
+
+    DataPacket* out = (DataPacket*)arena_alloc(a, (frames ? frames : 1) * sizeof(DataPacket));
+    size_t n = 0;
+    int ok = 1;
+    offset = 0;
+    while (n < frames) {
+        size_t frame = proto_get_u32(data + offset);
+        DataPacket_view view;
+        if (!decode_DataPacket_view(data + offset + 4, frame, &view)) {
+            ok = 0;
+            break;
+        }
+        fill_DataPacket_from_view(&out[n], &view, a);
+        offset += 4 + frame;
+        n++;
+    }
+    *msgs = out;
+    *count = n;
+    *used = offset;
+    return ok;
+}
@@ -0,0 +1,107 @@
+
+#include "proto_20a5e7a9.h"
+#include <stdlib.h>
+#include <string.h>
+
+size_t encoded_size_DataPacket(const DataPacket* msg) {
+    if (!msg) return 0;
+    size_t payload_len = proto_str_len(msg->payload, msg->payload_len);
+    if (payload_len > UINT32_MAX) return 0;
+    return 4 + 4 + 4 + payload_len + 4;
+}
+
+size_t encode_DataPacket_into(const DataPacket* msg, char* buf, size_t cap) {
+    if (!msg || !buf) return 0;
+    size_t payload_len = proto_str_len(msg->payload, msg->payload_len);
+    if (payload_len > UINT32_MAX) return 0;
+    size_t size = 4 + 4 + 4 + payload_len + 4;
+    if (cap < size) return 0;
+
+    char* p = buf;
+    proto_put_u32(p, DataPacket_TAG);
+    p += 4;
+    proto_put_u32(p, (uint32_t)msg->id);
+    p += 4;
+    proto_put_u32(p, (uint32_t)payload_len);
+    p += 4;
+    if (payload_len) memcpy(p, msg->payload, payload_len);
+    p += payload_len;
+    proto_put_u32(p, (uint32_t)msg->size);
+    p += 4;
+    return size;
+}
+
+int encode_DataPacket_iov(const DataPacket* msg, char* scratch, struct iovec* iov) {
+    if (!msg || !scratch || !iov) return 0;
+    size_t payload_len = proto_str_len(msg->payload, msg->payload_len);
+    if (payload_len > UINT32_MAX) return 0;
+
+    /* Fixed-size fields accumulate in scratch until a string interrupts them */
+    int count = 0;
+    char* run = scratch;
+    char* p = scratch;
+    proto_put_u32(p, DataPacket_TAG);
+    p += 4;
+    proto_put_u32(p, (uint32_t)msg->id);
+    p += 4;
+    proto_put_u32(p, (uint32_t)payload_len);
+    p += 4;
+    iov[count].iov_base = run;
+    iov[count].iov_len = (size_t)(p - run);
+    count++;
+    run = p;
+    if (payload_len) {
+        iov[count].iov_base = (void*)msg->payload;
+        iov[count].iov_len = payload_len;
+        count++;
+    }
+    proto_put_u32(p, (uint32_t)msg->size);
+    p += 4;
+    if (p != run) {
+        iov[count].iov_base = run;
+        iov[count].iov_len = (size_t)(p - run);
+        count++;
+    }
+    return count;
+}
+
+char* encode_DataPacket(const DataPacket* msg, size_t* out_len) {
+    if (!msg || !out_len) return NULL;
+
+    size_t size = encoded_size_DataPacket(msg);
+    if (size == 0) return NULL;
+    char* result = (char*)malloc(size + 0);
+    if (!result) return NULL;
+    if (encode_DataPacket_into(msg, result, size) != size) {
+        free(result);
+        return NULL;
+    }
+    *out_len = size;
+    return result;
+}
+
+size_t encoded_batch_size_DataPacket(const DataPacket* msgs, size_t count) {
+    if (!msgs) return 0;
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t n = encoded_size_DataPacket(&msgs[i]);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        size += 4 + n;
+    }
+    return size;
+}
+
+size_t encode_DataPacket_batch(const DataPacket* msgs, size_t count, char* arena, size_t cap) {
+    if (!msgs || !arena) return 0;
+    char* p = arena;
+    size_t left = cap;
+    for (size_t i = 0; i < count; i++) {
+        if (left < 4) return 0;
+        size_t n = encode_DataPacket_into(&msgs[i], p + 4, left - 4);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        proto_put_u32(p, (uint32_t)n);
+        p += 4 + n;
+        left -= 4 + n;
+    }
+    return (size_t)(p - arena);
+}
@@ -1,5 +1,5 @@
 
-#include "protocol_0d23cd47.h"
+#include "proto_20a5e7a9.h"
 #include <stdlib.h>
 
 void free_DataPacket(DataPacket* msg) {
@@ -0,0 +1,118 @@
+
+#include "proto_5d2f46e3.h"
+#include <stdlib.h>
+#include <string.h>
+
+int decode_LoginRequest_view(const char* data, size_t len, LoginRequest_view* view) {
+    static const char prefix[] = "LoginRequest|";
+    if (!data || !view) return 0;
+    if (len < sizeof(prefix) - 1 || memcmp(data, prefix, sizeof(prefix) - 1) != 0) return 0;
+
+    const char* p = data + sizeof(prefix) - 1;
+    const char* end = data + len;
+    const char* sep;
+
+    sep = (const char*)memchr(p, '|', (size_t)(end - p));
+    if (!sep) return 0;
+    view->username = p;
+    view->username_len = (size_t)(sep - p);
+    p = sep + 1;
+
+    sep = (const char*)memchr(p, '|', (size_t)(end - p));
+    if (!sep) return 0;
+    view->password = p;
+    view->password_len = (size_t)(sep - p);
+
+    return 1;
+}
+
+LoginRequest* decode_LoginRequest(const char* data, size_t len) {
+    LoginRequest_view view;
+    if (!decode_LoginRequest_view(data, len, &view)) return NULL;
+
+    LoginRequest* msg = (LoginRequest*)calloc(1, sizeof(LoginRequest));
+    if (!msg) return NULL;
+    msg->username = proto_strndup(view.username, view.username_len);
+    if (!msg->username) {
+        free_LoginRequest(msg);
+        return NULL;
+    }
+    msg->password = proto_strndup(view.password, view.password_len);
+    if (!msg->password) {
+        free_LoginRequest(msg);
+        return NULL;
+    }
+    return msg;
+}
+
+int decode_LoginRequest_batch(const char* data, size_t len, LoginRequest_view* views, size_t max_count,
+                              size_t* count, size_t* used) {
+    if (!data || !views || !count || !used) return 0;
+    size_t n = 0;
+    size_t offset = 0;
+    int ok = 1;
+    while (n < max_count && len - offset >= 4) {
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        if (!decode_LoginRequest_view(data + offset + 4, frame, &views[n])) {
+            ok = 0;
+            break;
+        }
+        offset += 4 + frame;
+        n++;
+    }
+    *count = n;
+    *used = offset;
+    return ok;
+}
+
+/* Fills msg from a decoded view with strings copied into the arena */
+static void fill_LoginRequest_from_view(LoginRequest* msg, const LoginRequest_view* view, arena* a) {
+    msg->username = arena_strndup(a, view->username, view->username_len);
+    msg->password = arena_strndup(a, view->password, view->password_len);
+}
+
+LoginRequest* decode_LoginRequest_arena(const char* data, size_t len, arena* a) {
+    if (!a) return decode_LoginRequest(data, len);
+    LoginRequest_view view;
+    if (!decode_LoginRequest_view(data, len, &view)) return NULL;
+
+    LoginRequest* msg = (LoginRequest*)arena_alloc(a, sizeof(LoginRequest));
+    fill_LoginRequest_from_view(msg, &view, a);
+    return msg;
+}
+
+int decode_LoginRequest_batch_arena(const char* data, size_t len, arena* a, LoginRequest** msgs,
+                                    size_t* count, size_t* used) {
+    if (!data || !a || !msgs || !count || !used) return 0;
+
+    /* The frame lengths give the count without touching message contents */
+    size_t frames = 0;
+    size_t offset = 0;
+    while (len - offset >= 4) {
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        offset += 4 + frame;
+        frames++;
+    }
+
+    LoginRequest* out = (LoginRequest*)arena_alloc(a, (frames ? frames : 1) * sizeof(LoginRequest));
+    size_t n = 0;
+    int ok = 1;
+    offset = 0;
+    while (n < frames) {
+        size_t frame = proto_get_u32(data + offset);
+        LoginRequest_view view;
+        if (!decode_LoginRequest_view(data + offset + 4, frame, &view)) {
+            ok = 0;
+            break;
+        }
+        fill_LoginRequest_from_view(&out[n], &view, a);
+        offset += 4 + frame;
+        n++;
+    }
+    *msgs = out;
+    *count = n;
+    *used = offset;
+    return ok;
+}
@@ -0,0 +1,76 @@
+
+#include "proto_5d2f46e3.h"
+#include <stdlib.h>
+#include <string.h>
+
+size_t encoded_size_LoginRequest(const LoginRequest* msg) {
+    if (!msg) return 0;
+    size_t username_len = msg->username ? strlen(msg->username) : 0;
+    if (username_len && memchr(msg->username, '|', username_len)) return 0;
+    size_t password_len = msg->password ? strlen(msg->password) : 0;
+    if (password_len && memchr(msg->password, '|', password_len)) return 0;
+    return sizeof("LoginRequest|") - 1 + username_len + 1 + password_len + 1;
+}
+
+size_t encode_LoginRequest_into(const LoginRequest* msg, char* buf, size_t cap) {
+    if (!msg || !buf) return 0;
+    size_t username_len = msg->username ? strlen(msg->username) : 0;
+    if (username_len && memchr(msg->username, '|', username_len)) return 0;
+    size_t password_len = msg->password ? strlen(msg->password) : 0;
+    if (password_len && memchr(msg->password, '|', password_len)) return 0;
+    size_t size = sizeof("LoginRequest|") - 1 + username_len + 1 + password_len + 1;
+    if (cap < size) return 0;
+
+    char* p = buf;
+    memcpy(p, "LoginRequest|", sizeof("LoginRequest|") - 1);
+    p += sizeof("LoginRequest|") - 1;
+    if (username_len) memcpy(p, msg->username, username_len);
+    p += username_len;
+    *p++ = '|';
+    if (password_len) memcpy(p, msg->password, password_len);
+    p += password_len;
+    *p++ = '|';
+    return size;
+}
+
+char* encode_LoginRequest(const LoginRequest* msg, size_t* out_len) {
+    if (!msg || !out_len) return NULL;
+
+    size_t size = encoded_size_LoginRequest(msg);
+    if (size == 0) return NULL;
+    char* result = (char*)malloc(size + 1);
+    if (!result) return NULL;
+    if (encode_LoginRequest_into(msg, result, size) != size) {
+        free(result);
+        return NULL;
+    }
+    result[size] = '\0';
+    *out_len = size;
+    return result;
+}
+
+size_t encoded_batch_size_LoginRequest(const LoginRequest* msgs, size_t count) {
+    if (!msgs) return 0;
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t n = encoded_size_LoginRequest(&msgs[i]);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        size += 4 + n;
+    }
+    return size;
+}
+
+size_t encode_LoginRequest_batch(const LoginRequest* msgs, size_t count, char* arena, size_t cap) {
+    if (!msgs || !arena) return 0;
+    char* p = arena;
+    size_t left = cap;
+    for (size_t i = 0; i < count; i++) {
+        if (left < 4) return 0;
+        size_t n = encode_LoginRequest_into(&msgs[i], p + 4, left - 4);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        proto_put_u32(p, (uint32_t)n);
+        p += 4 + n;
+        left -= 4 + n;
+    }
+    return (size_t)(p - arena);
+}
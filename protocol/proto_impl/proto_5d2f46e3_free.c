@@ -1,5 +1,5 @@
 
-#include "protocol_0d23cd47.h"
+#include "proto_5d2f46e3.h"
 #include <stdlib.h>
 
 void free_LoginRequest(LoginRequest* msg) {
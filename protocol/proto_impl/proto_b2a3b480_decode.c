@@ -0,0 +1,113 @@
+
+#include "proto_b2a3b480.h"
+#include <stdlib.h>
+#include <string.h>
+
+int decode_StatusUpdate_view(const char* data, size_t len, StatusUpdate_view* view) {
+    static const char prefix[] = "StatusUpdate|";
+    if (!data || !view) return 0;
+    if (len < sizeof(prefix) - 1 || memcmp(data, prefix, sizeof(prefix) - 1) != 0) return 0;
+
+    const char* p = data + sizeof(prefix) - 1;
+    const char* end = data + len;
+    const char* sep;
+
+    sep = (const char*)memchr(p, '|', (size_t)(end - p));
+    if (!sep) return 0;
+    if (!proto_parse_int(p, (size_t)(sep - p), &view->code)) return 0;
+    p = sep + 1;
+
+    sep = (const char*)memchr(p, '|', (size_t)(end - p));
+    if (!sep) return 0;
+    view->message = p;
+    view->message_len = (size_t)(sep - p);
+
+    return 1;
+}
+
+StatusUpdate* decode_StatusUpdate(const char* data, size_t len) {
+    StatusUpdate_view view;
+    if (!decode_StatusUpdate_view(data, len, &view)) return NULL;
+
+    StatusUpdate* msg = (StatusUpdate*)calloc(1, sizeof(StatusUpdate));
+    if (!msg) return NULL;
+    msg->code = view.code;
+    msg->message = proto_strndup(view.message, view.message_len);
+    if (!msg->message) {
+        free_StatusUpdate(msg);
+        return NULL;
+    }
+    return msg;
+}
+
+int decode_StatusUpdate_batch(const char* data, size_t len, StatusUpdate_view* views, size_t max_count,
+                              size_t* count, size_t* used) {
+    if (!data || !views || !count || !used) return 0;
+    size_t n = 0;
+    size_t offset = 0;
+    int ok = 1;
+    while (n < max_count && len - offset >= 4) {
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        if (!decode_StatusUpdate_view(data + offset + 4, frame, &views[n])) {
+            ok = 0;
+            break;
+        }
+        offset += 4 + frame;
+        n++;
+    }
+    *count = n;
+    *used = offset;
+    return ok;
+}
+
+/* Fills msg from a decoded view with strings copied into the arena */
+static void fill_StatusUpdate_from_view(StatusUpdate* msg, const StatusUpdate_view* view, arena* a) {
+    msg->code = view->code;
+    msg->message = arena_strndup(a, view->message, view->message_len);
+}
+
+StatusUpdate* decode_StatusUpdate_arena(const char* data, size_t len, arena* a) {
+    if (!a) return decode_StatusUpdate(data, len);
+    StatusUpdate_view view;
+    if (!decode_StatusUpdate_view(data, len, &view)) return NULL;
+
+    StatusUpdate* msg = (StatusUpdate*)arena_alloc(a, sizeof(StatusUpdate));
+    fill_StatusUpdate_from_view(msg, &view, a);
+    return msg;
+}
+
+int decode_StatusUpdate_batch_arena(const char* data, size_t len, arena* a, StatusUpdate** msgs,
+                                    size_t* count, size_t* used) {
+    if (!data || !a || !msgs || !count || !used) return 0;
+
+    /* The frame lengths give the count without touching message contents */
+    size_t frames = 0;
+    size_t offset = 0;
+    while (len - offset >= 4) {
+        size_t frame = proto_get_u32(data + offset);
+        if (len - offset - 4 < frame) break;
+        offset += 4 + frame;
+        frames++;
+    }
+
+    StatusUpdate* out = (StatusUpdate*)arena_alloc(a, (frames ? frames : 1) * sizeof(StatusUpdate));
+    size_t n = 0;
+    int ok = 1;
+    offset = 0;
+    while (n < frames) {
+        size_t frame = proto_get_u32(data + offset);
+        StatusUpdate_view view;
+        if (!decode_StatusUpdate_view(data + offset + 4, frame, &view)) {
+            ok = 0;
+            break;
+        }
+        fill_StatusUpdate_from_view(&out[n], &view, a);
+        offset += 4 + frame;
+        n++;
+    }
+    *msgs = out;
+    *count = n;
+    *used = offset;
+    return ok;
+}
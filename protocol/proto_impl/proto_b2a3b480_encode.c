@@ -0,0 +1,71 @@
+
+#include "proto_b2a3b480.h"
+#include <stdlib.h>
+#include <string.h>
+
+size_t encoded_size_StatusUpdate(const StatusUpdate* msg) {
+    if (!msg) return 0;
+    size_t message_len = msg->message ? strlen(msg->message) : 0;
+    if (message_len && memchr(msg->message, '|', message_len)) return 0;
+    return sizeof("StatusUpdate|") - 1 + proto_int_len(msg->code) + 1 + message_len + 1;
+}
+
+size_t encode_StatusUpdate_into(const StatusUpdate* msg, char* buf, size_t cap) {
+    if (!msg || !buf) return 0;
+    size_t message_len = msg->message ? strlen(msg->message) : 0;
+    if (message_len && memchr(msg->message, '|', message_len)) return 0;
+    size_t size = sizeof("StatusUpdate|") - 1 + proto_int_len(msg->code) + 1 + message_len + 1;
+    if (cap < size) return 0;
+
+    char* p = buf;
+    memcpy(p, "StatusUpdate|", sizeof("StatusUpdate|") - 1);
+    p += sizeof("StatusUpdate|") - 1;
+    p += proto_put_int(p, msg->code);
+    *p++ = '|';
+    if (message_len) memcpy(p, msg->message, message_len);
+    p += message_len;
+    *p++ = '|';
+    return size;
+}
+
+char* encode_StatusUpdate(const StatusUpdate* msg, size_t* out_len) {
+    if (!msg || !out_len) return NULL;
+
+    size_t size = encoded_size_StatusUpdate(msg);
+    if (size == 0) return NULL;
+    char* result = (char*)malloc(size + 1);
+    if (!result) return NULL;
+    if (encode_StatusUpdate_into(msg, result, size) != size) {
+        free(result);
+        return NULL;
+    }
+    result[size] = '\0';
+    *out_len = size;
+    return result;
+}
+
+size_t encoded_batch_size_StatusUpdate(const StatusUpdate* msgs, size_t count) {
+    if (!msgs) return 0;
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t n = encoded_size_StatusUpdate(&msgs[i]);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        size += 4 + n;
+    }
+    return size;
+}
+
+size_t encode_StatusUpdate_batch(const StatusUpdate* msgs, size_t count, char* arena, size_t cap) {
+    if (!msgs || !arena) return 0;
+    char* p = arena;
+    size_t left = cap;
+    for (size_t i = 0; i < count; i++) {
+        if (left < 4) return 0;
+        size_t n = encode_StatusUpdate_into(&msgs[i], p + 4, left - 4);
+        if (n == 0 || n > UINT32_MAX) return 0;
+        proto_put_u32(p, (uint32_t)n);
+        p += 4 + n;
+        left -= 4 + n;
+    }
+    return (size_t)(p - arena);
+}
@@ -1,5 +1,5 @@
 
-#include "protocol_0d23cd47.h"
+#include "proto_b2a3b480.h"
 #include <stdlib.h>
 
 void free_StatusUpdate(StatusUpdate* msg) {
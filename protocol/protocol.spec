@@ -2,7 +2,9 @@
 # SPDX-License-Identifier: MIT
 
 # Simple protocol specification
-# Format: MESSAGE <name> followed by FIELD <name> <type>
+# Format: MESSAGE <name> [text|binary] followed by FIELD <name> <type>
+# The optional wire format defaults to text ('|'-separated fields); binary
+# is little-endian with length-prefixed strings
 
 MESSAGE LoginRequest
   FIELD username string
@@ -12,7 +14,7 @@ MESSAGE StatusUpdate
   FIELD code int
   FIELD message string
 
-MESSAGE DataPacket
+MESSAGE DataPacket binary
   FIELD id int
   FIELD payload string
   FIELD size int
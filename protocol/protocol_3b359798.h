@@ -0,0 +1,9 @@
+
+#ifndef PROTOCOL_3B359798_H
+#define PROTOCOL_3B359798_H
+
+#include "proto_5d2f46e3.h"
+#include "proto_b2a3b480.h"
+#include "proto_20a5e7a9.h"
+
+#endif /* PROTOCOL_3B359798_H */
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: MIT
+
+# Time scalerun over generated BUILD trees of different shapes: graph load
+# (parsed and precompiled), a cold build and a no-op incremental rebuild.
+# One CSV row per shape.
+
+import argparse
+import csv
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+import generate_scaling
+
+SHAPE_KEYS = {
+    'nodes': int, 'avg_fanin': float, 'max_fanin': int, 'depth': int,
+    'dup_rate': float, 'files': int, 'file_size': int, 'seed': int,
+}
+DEFAULT_SHAPE = {
+    'nodes': 1000, 'avg_fanin': 8.0, 'max_fanin': 64, 'depth': 20,
+    'dup_rate': 0.03, 'files': 12, 'file_size': 138, 'seed': 1,
+}
+DEFAULT_SWEEP = ['nodes=250', 'nodes=500', 'nodes=1000', 'nodes=2000']
+
+COLUMNS = list(DEFAULT_SHAPE) + ['targets', 'edges', 'load_parse_s', 'load_mapped_s', 'cold_build_s',
+                                 'noop_build_s', 'noop_wall_s']
+
+def parse_shape(text):
+    shape = dict(DEFAULT_SHAPE)
+    for item in filter(None, text.split(',')):
+        key, _, value = item.partition('=')
+        key = key.strip().replace('-', '_')
+        if key not in SHAPE_KEYS:
+            raise ValueError('unknown shape key %s (expected one of %s)' % (key, ', '.join(SHAPE_KEYS)))
+        shape[key] = SHAPE_KEYS[key](value)
+    minimum = generate_scaling.MIN_FILE_SIZE
+    if shape['file_size'] < minimum:
+        raise ValueError('file_size %d is below the minimum of %d' % (shape['file_size'], minimum))
+    return shape
+
+def run_scalerun(scalerun, args):
+    start = time.monotonic()
+    result = subprocess.run([scalerun] + args, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    wall = time.monotonic() - start
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        raise RuntimeError('scalerun %s failed with status %d' % (' '.join(args), result.returncode))
+    return result.stdout, wall
+
+def reported(pattern, output):
+    match = re.search(pattern, output)
+    if not match:
+        raise RuntimeError('unexpected scalerun output:\n' + output)
+    return match.groups()
+
+def bench_shape(scalerun, shape, work_dir, extra_args, run_build):
+    tree = os.path.join(work_dir, 'tree')
+    state = os.path.join(work_dir, 'state')
+    generate_scaling.generate(tree, shape['nodes'], shape['avg_fanin'], shape['max_fanin'], shape['depth'],
+                              shape['dup_rate'], shape['files'], shape['file_size'], shape['seed'], run_build)
+    shutil.rmtree(state, ignore_errors=True)
+    base = ['-C', tree, '-s', state]
+
+    out, _ = run_scalerun(scalerun, base + ['-n', '-P'])
+    targets, load_parse = reported(r'Loaded (\d+) targets from \d+ BUILD files in ([\d.]+) s', out)
+    edges, = reported(r'(\d+) dependency edges', out)
+    run_scalerun(scalerun, base + ['-n'])
+    out, _ = run_scalerun(scalerun, base + ['-n'])
+    load_mapped, = reported(r'in ([\d.]+) s', out)
+
+    out, _ = run_scalerun(scalerun, base + extra_args)
+    cold, = reported(r'Ran \d+ targets in ([\d.]+) s', out)
+    out, noop_wall = run_scalerun(scalerun, base + extra_args + ['-i'])
+    noop, = reported(r'Ran \d+ targets in ([\d.]+) s', out)
+
+    row = dict(shape)
+    row.update(targets=targets, edges=edges, load_parse_s=load_parse, load_mapped_s=load_mapped, cold_build_s=cold,
+               noop_build_s=noop, noop_wall_s='%.3f' % noop_wall)
+    return row
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description='Time scalerun over generated BUILD trees')
+    parser.add_argument('--shape', action='append',
+                        help='comma-separated key=value overrides, e.g. nodes=2000,avg_fanin=16 '
+                             '(repeatable; default: a node-count sweep)')
+    parser.add_argument('--output', default='scaling_bench.csv', help='CSV file to write')
+    parser.add_argument('--scalerun', default=os.path.join(here, 'scalerun', 'scalerun'), help='scalerun binary')
+    parser.add_argument('--work-dir', help='where to generate trees (default: a temporary directory)')
+    parser.add_argument('-j', type=int, help='scalerun worker threads')
+    parser.add_argument('-m', dest='mode', help='scalerun action mode (script, inproc or verify)')
+    args = parser.parse_args()
+
+    if not os.access(args.scalerun, os.X_OK):
+        print('Error: %s not found; run make -C scaling/scalerun first' % args.scalerun, file=sys.stderr)
+        return 1
+    try:
+        shapes = [parse_shape(text) for text in (args.shape or DEFAULT_SWEEP)]
+    except ValueError as e:
+        print('Error: %s' % e, file=sys.stderr)
+        return 1
+
+    # Cold means cold: no action cache carried over between runs
+    extra_args = ['-x']
+    if args.j:
+        extra_args += ['-j', str(args.j)]
+    if args.mode:
+        extra_args += ['-m', args.mode]
+
+    work_dir = args.work_dir or tempfile.mkdtemp(prefix='scaling_bench_')
+    run_build = os.path.join(here, 'geomorphy', 'run_build.sh')
+    try:
+        with open(args.output, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=COLUMNS)
+            writer.writeheader()
+            for shape in shapes:
+                row = bench_shape(args.scalerun, shape, work_dir, extra_args, run_build)
+                writer.writerow(row)
+                f.flush()
+                print('nodes=%d: load %s s (mapped %s s), cold %s s, no-op %s s' %
+                      (shape['nodes'], row['load_parse_s'], row['load_mapped_s'], row['cold_build_s'],
+                       row['noop_wall_s']))
+    except RuntimeError as e:
+        print('Error: %s' % e, file=sys.stderr)
+        return 1
+    finally:
+        if not args.work_dir:
+            shutil.rmtree(work_dir, ignore_errors=True)
+
+    print('Wrote %s' % args.output)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
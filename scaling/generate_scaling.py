@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: MIT
+
+# Generate a BUILD tree shaped like scaling/, with a tunable graph:
+# every component is a shell_sources target with its files plus an
+# adhoc_tool that runs geomorphy/run_build.sh over them and its
+# dependencies' outputs, and //:go depends on every component nothing
+# else depends on.
+
+import argparse
+import os
+import random
+import shutil
+import sys
+
+HEADER = '''# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: MIT
+'''
+
+GEOMORPHY_BUILD = HEADER + '''
+shell_sources(
+    name="run_build_script",
+    sources=[
+        "run_build.sh",
+    ],
+)
+
+system_binary(
+    name="bash",
+    binary_name="bash",
+)
+system_binary(
+    name="cat",
+    binary_name="cat",
+)
+system_binary(
+    name="md5sum",
+    binary_name="md5sum",
+)
+system_binary(
+    name="cut",
+    binary_name="cut",
+    fingerprint_args=["-f", "1", "/dev/null",],
+    fingerprint="",
+)
+'''
+
+def package_of(index):
+    # Two directory levels keep directories small at any node count
+    return 'gen/p%03d/c%06d' % (index // 1000, index)
+
+def output_of(package):
+    return package.replace('/', '_') + '_output.txt'
+
+def assign_levels(nodes, depth, rng):
+    # Every level gets at least one node so the longest chain is 'depth'
+    depth = max(1, min(depth, nodes))
+    levels = list(range(depth)) + [rng.randrange(depth) for _ in range(nodes - depth)]
+    levels.sort()
+    return levels
+
+def sample_fanin(avg_fanin, max_fanin, rng):
+    # Geometric around the average, clipped to [1, max_fanin]
+    if avg_fanin <= 1:
+        return 1
+    p = 1.0 / avg_fanin
+    count = 1
+    while count < max_fanin and rng.random() > p:
+        count += 1
+    return count
+
+def build_edges(levels, avg_fanin, max_fanin, dup_rate, rng):
+    first_of_level = {}
+    for index, level in enumerate(levels):
+        first_of_level.setdefault(level, index)
+
+    edges = []
+    for index, level in enumerate(levels):
+        if level == 0:
+            edges.append([])
+            continue
+        lower = first_of_level[level]
+        previous = first_of_level[level - 1]
+        fanin = min(sample_fanin(avg_fanin, max_fanin, rng), lower)
+
+        # One dependency on the level just below fixes the depth; the rest
+        # can come from anywhere underneath
+        deps = {rng.randrange(previous, lower)}
+        while len(deps) < fanin:
+            deps.add(rng.randrange(lower))
+        deps = sorted(deps)
+
+        declared = []
+        for dep in deps:
+            declared.append(dep)
+            if rng.random() < dup_rate:
+                declared.append(dep)
+        edges.append(declared)
+    return edges
+
+# A seed file is the license header, a blank line and random digits, and
+# --file-size counts all of it: the default gives the 138-byte files of
+# scaling/.  Anything shorter than this would leave no digits, and every
+# seed file would be the same.
+MIN_FILE_SIZE = len(HEADER) + 2
+
+def random_content(size, rng):
+    body = ''.join(rng.choice('0123456789') for _ in range(size - len(HEADER) - 1))
+    return HEADER + '\n' + body
+
+def write_file(path, text):
+    with open(path, 'w') as f:
+        f.write(text)
+
+def write_component(out_dir, index, deps, files, file_size, rng):
+    package = package_of(index)
+    directory = os.path.join(out_dir, package)
+    os.makedirs(directory, exist_ok=True)
+
+    sources = ['test.txt'] + ['random_seed_%02d.txt' % i for i in range(1, files)]
+    write_file(os.path.join(directory, 'test.txt'), HEADER + '\n' + package + '/test.txt\n')
+    for name in sources[1:]:
+        write_file(os.path.join(directory, name), random_content(file_size, rng))
+
+    output = output_of(package)
+    lines = [HEADER, 'shell_sources(', '    name="output_sources",', '    sources=[']
+    lines += ['        "%s",' % name for name in sources]
+    lines += ['    ],', ')', '', 'adhoc_tool(', '    name="output",', '    execution_dependencies=[',
+              '        ":output_sources",']
+    lines += ['        "%s:output",' % package_of(dep) for dep in deps]
+    lines += ['        "geomorphy:run_build_script",', '    ],', '    output_files=[', '        "%s",' % output,
+              '    ],', '    runnable="geomorphy:bash",',
+              '    args=["{chroot}/common_scripts/run_build.sh", "{chroot}", "%s",],' % output,
+              '    runnable_dependencies=[', '        "geomorphy:cat",', '        "geomorphy:md5sum",',
+              '        "geomorphy:cut",', '    ],', ')', '']
+    write_file(os.path.join(directory, 'BUILD'), '\n'.join(lines))
+
+def generate(out_dir, nodes, avg_fanin, max_fanin, depth, dup_rate, files, file_size, seed, run_build):
+    """Write the tree and return (targets, declared edges)."""
+    if file_size < MIN_FILE_SIZE:
+        raise ValueError('file size %d leaves no room for random digits (minimum %d)' % (file_size, MIN_FILE_SIZE))
+    rng = random.Random(seed)
+    if os.path.exists(out_dir):
+        shutil.rmtree(out_dir)
+    os.makedirs(os.path.join(out_dir, 'geomorphy'))
+    write_file(os.path.join(out_dir, 'geomorphy', 'BUILD'), GEOMORPHY_BUILD)
+    shutil.copy(run_build, os.path.join(out_dir, 'geomorphy', 'run_build.sh'))
+
+    levels = assign_levels(nodes, depth, rng)
+    edges = build_edges(levels, avg_fanin, max_fanin, dup_rate, rng)
+
+    has_dependents = [False] * nodes
+    for index in range(nodes):
+        write_component(out_dir, index, edges[index], files, file_size, rng)
+        for dep in edges[index]:
+            has_dependents[dep] = True
+
+    sinks = [index for index in range(nodes) if not has_dependents[index]]
+    lines = [HEADER, 'run_shell_command(', '    name="go",', '    execution_dependencies=[']
+    lines += ['        "//%s:output",' % package_of(index) for index in sinks]
+    lines += ['    ],', '    command="ls -l {chroot}",', ')', '']
+    write_file(os.path.join(out_dir, 'BUILD'), '\n'.join(lines))
+
+    # Components declare their sources and the build script besides their
+    # dependencies; geomorphy adds five targets and the root one
+    declared = sum(len(deps) + 2 for deps in edges) + len(sinks)
+    return 2 * nodes + 6, declared
+
+def file_size_arg(text):
+    size = int(text)
+    if size < MIN_FILE_SIZE:
+        raise argparse.ArgumentTypeError('%d is below %d, the %d-byte header plus a newline and one digit'
+                                         % (size, MIN_FILE_SIZE, len(HEADER)))
+    return size
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description='Generate a scaling/-style BUILD tree with a tunable shape')
+    parser.add_argument('out_dir', help='directory to create (replaced if it exists)')
+    parser.add_argument('--nodes', type=int, default=1000, help='number of components (default: 1000)')
+    parser.add_argument('--avg-fanin', type=float, default=8.0, help='average dependencies per component')
+    parser.add_argument('--max-fanin', type=int, default=64, help='maximum dependencies per component')
+    parser.add_argument('--depth', type=int, default=20, help='number of levels, the longest chain')
+    parser.add_argument('--dup-rate', type=float, default=0.03, help='chance an edge is declared twice')
+    parser.add_argument('--files', type=int, default=12, help='source files per component')
+    parser.add_argument('--file-size', type=file_size_arg, default=138,
+                        help='bytes per random seed file, header included (minimum %d)' % MIN_FILE_SIZE)
+    parser.add_argument('--seed', type=int, default=1, help='random seed')
+    args = parser.parse_args()
+
+    if args.nodes < 1 or args.files < 1 or args.max_fanin < 1 or args.depth < 1:
+        print('Error: --nodes, --files, --max-fanin and --depth must be positive', file=sys.stderr)
+        return 1
+
+    targets, declared = generate(args.out_dir, args.nodes, args.avg_fanin, args.max_fanin, args.depth,
+                                 args.dup_rate, args.files, args.file_size, args.seed,
+                                 os.path.join(here, 'geomorphy', 'run_build.sh'))
+    print('Generated %d targets with %d declared edges in %s' % (targets, declared, args.out_dir))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
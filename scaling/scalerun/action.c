@@ -0,0 +1,518 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "action.h"
+#include "common.h"
+#include "md5.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+static char* find_program(const char* name) {
+    const char* path = getenv("PATH");
+    if (!path) path = "/usr/bin:/bin";
+
+    char candidate[PATH_MAX];
+    while (*path) {
+        const char* sep = strchr(path, ':');
+        size_t len = sep ? (size_t)(sep - path) : strlen(path);
+        snprintf(candidate, sizeof(candidate), "%.*s/%s", (int)len, path, name);
+        if (len && access(candidate, X_OK) == 0) return xstrdup(candidate);
+        path += len + (sep ? 1 : 0);
+    }
+    return NULL;
+}
+
+static int copy_file(const char* src, const char* dest) {
+    int in = open(src, O_RDONLY | O_CLOEXEC);
+    if (in < 0) return 0;
+    int out = open(dest, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        close(in);
+        return 0;
+    }
+
+    char buffer[65536];
+    ssize_t n;
+    int ok = 1;
+    while ((n = read(in, buffer, sizeof(buffer))) > 0) {
+        if (write(out, buffer, (size_t)n) != n) {
+            ok = 0;
+            break;
+        }
+    }
+    if (n < 0) ok = 0;
+    close(in);
+    if (close(out) != 0) ok = 0;
+    return ok;
+}
+
+// Hard-link 'src' into the chroot; fall back to a copy across filesystems
+static int place_file(const char* src, const char* dest) {
+    if (link(src, dest) == 0 || errno == EEXIST) return 1;
+
+    if (errno == ENOENT) {
+        char parent[PATH_MAX];
+        snprintf(parent, sizeof(parent), "%s", dest);
+        char* slash = strrchr(parent, '/');
+        if (slash) *slash = '\0';
+        if (!make_dirs(parent)) return 0;
+        if (link(src, dest) == 0 || errno == EEXIST) return 1;
+    }
+
+    if (errno == EXDEV || errno == EPERM || errno == EMLINK) return copy_file(src, dest);
+    return 0;
+}
+
+static int materialize(action_context* ctx, uint32_t target, const char* chroot) {
+    const build_graph* g = ctx->graph;
+    char src[PATH_MAX], dest[PATH_MAX];
+
+    for (uint32_t i = g->dep_index[target]; i < g->dep_index[target + 1]; i++) {
+        uint32_t dep = g->deps[i];
+
+        if (g->kind[dep] == TARGET_SOURCES) {
+            for (uint32_t j = g->src_index[dep]; j < g->src_index[dep + 1]; j++) {
+                const char* path = graph_str(g, g->srcs[j]);
+                if (!join_path(src, sizeof(src), ctx->root, path) || !join_path(dest, sizeof(dest), chroot, path) ||
+                    !place_file(src, dest)) {
+                    fprintf(stderr, "Error: Cannot stage %s for //%s\n", src, graph_str(g, g->label[target]));
+                    return 0;
+                }
+            }
+        } else if (g->kind[dep] == TARGET_TOOL) {
+            const char* name = graph_str(g, g->output[dep]);
+            if (!join_path(src, sizeof(src), ctx->out_dir, name) || !join_path(dest, sizeof(dest), chroot, name) ||
+                !place_file(src, dest)) {
+                fprintf(stderr, "Error: Missing output %s of //%s\n", src, graph_str(g, g->label[dep]));
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Replace every "{chroot}" in 'command' with the chroot path
+static char* expand_command(const char* command, const char* chroot) {
+    size_t cap = strlen(command) + 1;
+    for (const char* p = command; (p = strstr(p, "{chroot}")) != NULL; p += 8) cap += strlen(chroot);
+
+    char* result = xmalloc(cap);
+    char* out = result;
+    while (*command) {
+        if (strncmp(command, "{chroot}", 8) == 0) {
+            out = stpcpy(out, chroot);
+            command += 8;
+        } else {
+            *out++ = *command++;
+        }
+    }
+    *out = '\0';
+    return result;
+}
+
+static int spawn_and_wait(action_context* ctx, char* const argv[], const char* cwd, const char* log_path) {
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addchdir_np(&actions, cwd);
+    if (log_path) {
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+    }
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+
+    pid_t pid;
+    int err = posix_spawn(&pid, argv[0], &actions, NULL, argv, ctx->envp);
+    posix_spawn_file_actions_destroy(&actions);
+    if (err != 0) {
+        fprintf(stderr, "Error: Cannot run %s: %s\n", argv[0], strerror(err));
+        return -1;
+    }
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    if (WIFEXITED(status)) return WEXITSTATUS(status);
+    return 128 + (WIFSIGNALED(status) ? WTERMSIG(status) : 0);
+}
+
+// The build script is the first *.sh among the target's sources
+static const char* find_script(const action_context* ctx, uint32_t target) {
+    const build_graph* g = ctx->graph;
+    for (uint32_t i = g->dep_index[target]; i < g->dep_index[target + 1]; i++) {
+        uint32_t dep = g->deps[i];
+        if (g->kind[dep] != TARGET_SOURCES) continue;
+        for (uint32_t j = g->src_index[dep]; j < g->src_index[dep + 1]; j++) {
+            const char* path = graph_str(g, g->srcs[j]);
+            size_t len = strlen(path);
+            if (len > 3 && strcmp(path + len - 3, ".sh") == 0) return path;
+        }
+    }
+    return NULL;
+}
+
+static int digest_sources(action_context* ctx, uint32_t target) {
+    const build_graph* g = ctx->graph;
+    char path[PATH_MAX];
+    md5_ctx md5;
+    md5_init(&md5);
+
+    for (uint32_t i = g->src_index[target]; i < g->src_index[target + 1]; i++) {
+        const char* src = graph_str(g, g->srcs[i]);
+        uint8_t digest[16];
+        struct stat st;
+        int fd = join_path(path, sizeof(path), ctx->root, src) ? open(path, O_RDONLY | O_CLOEXEC) : -1;
+        int ok = fd >= 0 && fstat(fd, &st) == 0 && md5_fd(fd, digest);
+        if (fd >= 0) close(fd);
+        if (!ok) {
+            fprintf(stderr, "Error: Cannot read %s for //%s\n", path, graph_str(g, g->label[target]));
+            return 0;
+        }
+        md5_update(&md5, src, strlen(src) + 1);
+        md5_update(&md5, digest, sizeof(digest));
+
+        // Stamp taken before the read: a concurrent edit shows up next run
+        if (ctx->state) {
+            state_stamp(&ctx->state->stamp[i], &st);
+            memcpy(ctx->state->file_digest[i], digest, 16);
+            ctx->state->file_known[i] = 1;
+        }
+    }
+    md5_final(&md5, ctx->digest[target]);
+    ctx->done[target] = 1;
+    return 1;
+}
+
+// Remember a tool's output: its content digest, and the md5 it carries
+static int record_output(action_context* ctx, uint32_t target, const char* path) {
+    size_t len;
+    char* data = read_file(path, &len);
+    if (!data) return 0;
+
+    md5_ctx md5;
+    md5_init(&md5);
+    md5_update(&md5, data, len);
+    md5_final(&md5, ctx->digest[target]);
+
+    int known = len == 33 && data[32] == '\n';
+    for (int i = 0; known && i < 16; i++) {
+        unsigned int byte;
+        known = sscanf(data + i * 2, "%2x", &byte) == 1;
+        ctx->result[target][i] = (uint8_t)byte;
+    }
+    ctx->result_known[target] = (uint8_t)known;
+    free(data);
+    return 1;
+}
+
+// The files run_build.sh would find in the target's chroot, without making
+// one: dependency outputs come from memory when we know what they say, sources
+// straight from the checkout. The chroot is listed in sorted order.
+static int hash_direct_inputs(action_context* ctx, uint32_t target, uint8_t result[16], runbuild_bytes* bytes) {
+    const build_graph* g = ctx->graph;
+    size_t cap = 0;
+    for (uint32_t i = g->dep_index[target]; i < g->dep_index[target + 1]; i++) {
+        uint32_t dep = g->deps[i];
+        if (g->kind[dep] == TARGET_TOOL) cap++;
+        if (g->kind[dep] == TARGET_SOURCES) cap += g->src_index[dep + 1] - g->src_index[dep];
+    }
+
+    runbuild_input* all = xcalloc(cap ? cap : 1, sizeof(runbuild_input));
+    char (*text)[33] = xmalloc((cap ? cap : 1) * sizeof(*text));
+    size_t num_all = 0;
+    char path[PATH_MAX];
+    int ok = 1;
+
+    for (uint32_t i = g->dep_index[target]; ok && i < g->dep_index[target + 1]; i++) {
+        uint32_t dep = g->deps[i];
+        if (g->kind[dep] == TARGET_TOOL) {
+            runbuild_input* input = &all[num_all];
+            input->name = graph_str(g, g->output[dep]);
+            if (ctx->result_known[dep]) {
+                md5_hex(ctx->result[dep], text[num_all]);
+                text[num_all][32] = '\n';
+                input->data = text[num_all];
+                input->len = 33;
+            } else if (join_path(path, sizeof(path), ctx->out_dir, input->name)) {
+                input->disk_path = xstrdup(path);
+            } else {
+                ok = 0;
+            }
+            num_all++;
+        } else if (g->kind[dep] == TARGET_SOURCES) {
+            for (uint32_t j = g->src_index[dep]; ok && j < g->src_index[dep + 1]; j++) {
+                runbuild_input* input = &all[num_all++];
+                input->name = graph_str(g, g->srcs[j]);
+                if (join_path(path, sizeof(path), ctx->root, input->name)) input->disk_path = xstrdup(path);
+                else ok = 0;
+            }
+        }
+    }
+
+    // One file per path, as in the chroot; the root-level ones are what '*' matches
+    runbuild_sort(all, num_all);
+    size_t unique = 0;
+    for (size_t i = 0; i < num_all; i++) {
+        if (unique && strcmp(all[unique - 1].name, all[i].name) == 0) {
+            free((char*)all[i].disk_path);
+            continue;
+        }
+        all[unique++] = all[i];
+    }
+    num_all = unique;
+
+    runbuild_input* top = xcalloc(num_all ? num_all : 1, sizeof(runbuild_input));
+    size_t num_top = 0;
+    for (size_t i = 0; i < num_all; i++) {
+        if (!strchr(all[i].name, '/')) top[num_top++] = all[i];
+    }
+
+    ok = ok && runbuild_hash(top, num_top, all, num_all, result, bytes);
+    for (size_t i = 0; i < num_all; i++) free((char*)all[i].disk_path);
+    free(top);
+    free(text);
+    free(all);
+    return ok;
+}
+
+// Hash the target in-process and write its output the way run_build.sh would
+static int run_inproc(action_context* ctx, uint32_t target, const char* output) {
+    const build_graph* g = ctx->graph;
+    uint8_t result[16];
+    if (!hash_direct_inputs(ctx, target, result, &ctx->bytes[target])) {
+        fprintf(stderr, "Error: Cannot read the inputs of //%s\n", graph_str(g, g->label[target]));
+        return 0;
+    }
+
+    char text[34], tmp[PATH_MAX];
+    md5_hex(result, text);
+    text[32] = '\n';
+    int fd = snprintf(tmp, sizeof(tmp), "%s.tmp%u", output, target) < (int)sizeof(tmp)
+                 ? open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+                 : -1;
+    int ok = fd >= 0 && write(fd, text, 33) == 33;
+    if (fd >= 0 && close(fd) != 0) ok = 0;
+    if (!ok || rename(tmp, output) != 0) {
+        fprintf(stderr, "Error: Cannot write %s\n", output);
+        unlink(tmp);
+        return 0;
+    }
+
+    md5_ctx md5;
+    md5_init(&md5);
+    md5_update(&md5, text, 33);
+    md5_final(&md5, ctx->digest[target]);
+    memcpy(ctx->result[target], result, 16);
+    ctx->result_known[target] = 1;
+    return 1;
+}
+
+// Cache key: the command line plus the name and digest of every input
+static void action_key(const action_context* ctx, uint32_t target, char* const argv[], uint8_t key[16]) {
+    const build_graph* g = ctx->graph;
+    md5_ctx md5;
+    md5_init(&md5);
+    md5_update(&md5, "scalerun-action-v1", 19);
+    for (int i = 0; argv[i]; i++) md5_update(&md5, argv[i], strlen(argv[i]) + 1);
+
+    for (uint32_t i = g->dep_index[target]; i < g->dep_index[target + 1]; i++) {
+        uint32_t dep = g->deps[i];
+        if (g->kind[dep] != TARGET_SOURCES && g->kind[dep] != TARGET_TOOL) continue;
+        const char* name = graph_str(g, g->kind[dep] == TARGET_TOOL ? g->output[dep] : g->label[dep]);
+        md5_update(&md5, &g->kind[dep], 1);
+        md5_update(&md5, name, strlen(name) + 1);
+        md5_update(&md5, ctx->digest[dep], 16);
+    }
+    md5_final(&md5, key);
+}
+
+int action_init(action_context* ctx, const build_graph* graph, const char* root, const char* state_dir,
+                action_cache* cache, build_state* state, action_mode mode) {
+    if (!ctx || !graph || !root || !state_dir) return 0;
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->graph = graph;
+    ctx->cache = cache;
+    ctx->state = state;
+    ctx->mode = mode;
+    ctx->digest = xcalloc(graph->num_targets, sizeof(*ctx->digest));
+    ctx->done = xcalloc(graph->num_targets, sizeof(uint8_t));
+    ctx->cache_hit = xcalloc(graph->num_targets, sizeof(uint8_t));
+    ctx->result = xcalloc(graph->num_targets, sizeof(*ctx->result));
+    ctx->result_known = xcalloc(graph->num_targets, sizeof(uint8_t));
+    ctx->bytes = xcalloc(graph->num_targets, sizeof(runbuild_bytes));
+
+    char path[PATH_MAX];
+    if (!realpath(root, path)) {
+        fprintf(stderr, "Error: Cannot resolve %s\n", root);
+        return 0;
+    }
+    ctx->root = xstrdup(path);
+
+    if (!make_dirs(state_dir) || !realpath(state_dir, path)) {
+        fprintf(stderr, "Error: Cannot create state directory %s\n", state_dir);
+        return 0;
+    }
+    size_t len = strlen(path) + 16;
+    ctx->out_dir = xmalloc(len);
+    ctx->sandbox_dir = xmalloc(len);
+    snprintf(ctx->out_dir, len, "%s/out", path);
+    snprintf(ctx->sandbox_dir, len, "%s/sandbox", path);
+    if (!make_dirs(ctx->out_dir) || !remove_tree(ctx->sandbox_dir) || !make_dirs(ctx->sandbox_dir)) {
+        fprintf(stderr, "Error: Cannot prepare %s\n", path);
+        return 0;
+    }
+
+    ctx->bash = find_program("bash");
+    ctx->shell = find_program("sh");
+    if (!ctx->bash || !ctx->shell) {
+        fprintf(stderr, "Error: bash and sh must be on PATH\n");
+        return 0;
+    }
+
+    // Same environment as ours, but with a fixed collation order for globs
+    size_t count = 0;
+    while (environ[count]) count++;
+    ctx->envp = xcalloc(count + 2, sizeof(char*));
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (strncmp(environ[i], "LC_ALL=", 7) != 0) ctx->envp[n++] = environ[i];
+    }
+    ctx->envp[n] = "LC_ALL=C";
+    return 1;
+}
+
+void action_cleanup(action_context* ctx) {
+    if (!ctx) return;
+    free(ctx->root);
+    free(ctx->out_dir);
+    free(ctx->sandbox_dir);
+    free(ctx->bash);
+    free(ctx->shell);
+    free(ctx->envp);
+    free(ctx->digest);
+    free(ctx->done);
+    free(ctx->cache_hit);
+    free(ctx->result);
+    free(ctx->result_known);
+    free(ctx->bytes);
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+int action_run(void* context, uint32_t target, int worker) {
+    (void)worker;
+    action_context* ctx = context;
+    const build_graph* g = ctx->graph;
+    uint8_t kind = g->kind[target];
+    if (kind == TARGET_SOURCES) return digest_sources(ctx, target);
+    if (kind != TARGET_TOOL && kind != TARGET_COMMAND) {
+        ctx->done[target] = 1;
+        return 1;
+    }
+
+    const char* label = graph_str(g, g->label[target]);
+    const char* name = graph_str(g, g->output[target]);
+    char chroot[PATH_MAX], log_path[PATH_MAX], output[PATH_MAX];
+    snprintf(chroot, sizeof(chroot), "%s/%u", ctx->sandbox_dir, target);
+    snprintf(log_path, sizeof(log_path), "%s/%u.log", ctx->sandbox_dir, target);
+    join_path(output, sizeof(output), ctx->out_dir, name);
+
+    char* script = (char*)find_script(ctx, target);
+    char* tool_argv[] = {ctx->bash, script, "{chroot}", (char*)name, NULL};
+    char* inproc_argv[] = {"scalerun-inproc", script, "{chroot}", (char*)name, NULL};
+    uint8_t key[16];
+    if (kind == TARGET_TOOL) {
+        if (!script) {
+            fprintf(stderr, "Error: //%s has no build script among its dependencies\n", label);
+            return 0;
+        }
+        // A cached script output would leave nothing to verify
+        action_key(ctx, target, ctx->mode == ACTION_INPROC ? inproc_argv : tool_argv, key);
+        if (ctx->cache && ctx->mode != ACTION_VERIFY && cache_lookup(ctx->cache, key, output) && record_output(ctx, target, output)) {
+            atomic_fetch_add(&ctx->cache_hits, 1);
+            ctx->cache_hit[target] = 1;
+            ctx->done[target] = 1;
+            return 1;
+        }
+        atomic_fetch_add(&ctx->cache_misses, 1);
+
+        if (ctx->mode == ACTION_INPROC) {
+            if (!run_inproc(ctx, target, output)) return 0;
+            if (ctx->cache && !cache_store(ctx->cache, key, output)) {
+                fprintf(stderr, "Warning: Cannot cache the output of //%s\n", label);
+            }
+            ctx->done[target] = 1;
+            return 1;
+        }
+    }
+
+    if (!make_dirs(chroot) || !materialize(ctx, target, chroot)) return 0;
+
+    int status;
+    if (kind == TARGET_TOOL) {
+        tool_argv[2] = chroot;
+        status = spawn_and_wait(ctx, tool_argv, chroot, log_path);
+    } else {
+        char* command = expand_command(graph_str(g, g->command[target]), chroot);
+        char* argv[] = {ctx->shell, "-c", command, NULL};
+        status = spawn_and_wait(ctx, argv, chroot, NULL);
+        free(command);
+    }
+
+    if (status != 0) {
+        fprintf(stderr, "Error: //%s failed with status %d (chroot %s, log %s)\n", label, status, chroot,
+                log_path);
+        return 0;
+    }
+
+    if (kind == TARGET_TOOL) {
+        // Verify: re-hash the chroot as the script listed it, in find order
+        uint8_t expected[16];
+        if (ctx->mode == ACTION_VERIFY) {
+            runbuild_scan scan;
+            int hashed = runbuild_scan_chroot(chroot, name, &scan) &&
+                         runbuild_hash(scan.top, scan.num_top, scan.all, scan.num_all, expected, &ctx->bytes[target]);
+            runbuild_scan_free(&scan);
+            if (!hashed) {
+                fprintf(stderr, "Error: Cannot hash the chroot %s of //%s\n", chroot, label);
+                return 0;
+            }
+        }
+
+        char produced[PATH_MAX];
+        if (!join_path(produced, sizeof(produced), chroot, name) || rename(produced, output) != 0 ||
+            !record_output(ctx, target, output)) {
+            fprintf(stderr, "Error: //%s did not produce %s\n", label, name);
+            return 0;
+        }
+
+        if (ctx->mode == ACTION_VERIFY &&
+            (!ctx->result_known[target] || memcmp(expected, ctx->result[target], 16) != 0)) {
+            char hex[33];
+            md5_hex(expected, hex);
+            fprintf(stderr, "Error: //%s: in-process hash %s does not match %s (chroot %s)\n", label, hex, output,
+                    chroot);
+            return 0;
+        }
+        if (ctx->cache && !cache_store(ctx->cache, key, output)) {
+            fprintf(stderr, "Warning: Cannot cache the output of //%s\n", label);
+        }
+    }
+
+    remove_tree(chroot);
+    unlink(log_path);
+    ctx->done[target] = 1;
+    return 1;
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_ACTION_H
+#define SCALERUN_ACTION_H
+
+#include "cache.h"
+#include "graph.h"
+#include "runbuild.h"
+#include "state.h"
+#include <stdatomic.h>
+#include <stdint.h>
+
+// How adhoc_tool actions run
+typedef enum {
+    ACTION_SCRIPT,          // materialize a chroot and run the build script
+    ACTION_INPROC,          // hash the direct inputs in-process, as run_build.sh would
+    ACTION_VERIFY,          // run the script, then check the in-process hash against it
+} action_mode;
+
+// Shared state for running target actions
+typedef struct {
+    const build_graph* graph;
+    char* root;             // absolute scaling root
+    char* out_dir;          // <state>/out: one output file per adhoc_tool
+    char* sandbox_dir;      // <state>/sandbox: per-target chroots and logs
+    char* bash;
+    char* shell;
+    char** envp;            // environment for actions, with LC_ALL=C
+
+    // Content digest per target: md5 of a tool's output file, or of the
+    // (path, md5) list of a shell_sources target
+    uint8_t (*digest)[16];
+    uint8_t* done;          // target finished successfully in this run
+    uint8_t* cache_hit;     // ... by reusing a cached output
+
+    // The md5 a run_build.sh tool wrote as its output, when it parsed as one
+    uint8_t (*result)[16];
+    uint8_t* result_known;
+
+    action_mode mode;
+    runbuild_bytes* bytes;  // per tool: what hashing its inputs streamed and read
+    action_cache* cache;    // NULL when caching is disabled
+    build_state* state;     // source file stamps are recorded here
+    _Atomic uint32_t cache_hits;
+    _Atomic uint32_t cache_misses;
+} action_context;
+
+int action_init(action_context* ctx, const build_graph* graph, const char* root, const char* state_dir,
+                action_cache* cache, build_state* state, action_mode mode);
+void action_cleanup(action_context* ctx);
+
+// sched_task_fn: digest sources, or materialize the target's chroot and run its command
+int action_run(void* ctx, uint32_t target, int worker);
+
+#endif // SCALERUN_ACTION_H
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "cache.h"
+#include "common.h"
+#include "md5.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void entry_path(const action_cache* cache, const uint8_t key[16], char* path, size_t size) {
+    char hex[33];
+    md5_hex(key, hex);
+    snprintf(path, size, "%s/%.2s/%s", cache->dir, hex, hex);
+}
+
+// Entries are hard links, so publishing one is link-to-temp plus rename
+static int link_replace(const char* src, const char* dest) {
+    char tmp[PATH_MAX];
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", dest, (long)gettid());
+    unlink(tmp);
+    if (link(src, tmp) != 0) return 0;
+    if (rename(tmp, dest) != 0) {
+        unlink(tmp);
+        return 0;
+    }
+    return 1;
+}
+
+int cache_init(action_cache* cache, const char* state_dir) {
+    if (!cache || !state_dir) return 0;
+
+    size_t len = strlen(state_dir) + 8;
+    cache->dir = xmalloc(len);
+    snprintf(cache->dir, len, "%s/cache", state_dir);
+
+    char path[PATH_MAX];
+    for (int i = 0; i < 256; i++) {
+        snprintf(path, sizeof(path), "%s/%02x", cache->dir, i);
+        if (!make_dirs(path)) {
+            fprintf(stderr, "Error: Cannot create cache directory %s\n", path);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void cache_cleanup(action_cache* cache) {
+    if (!cache) return;
+    free(cache->dir);
+    cache->dir = NULL;
+}
+
+int cache_lookup(const action_cache* cache, const uint8_t key[16], const char* dest) {
+    if (!cache || !cache->dir) return 0;
+
+    char path[PATH_MAX];
+    entry_path(cache, key, path, sizeof(path));
+
+    // Already materialized from this entry: nothing to do
+    struct stat entry, existing;
+    if (stat(path, &entry) != 0) return 0;
+    if (stat(dest, &existing) == 0 && existing.st_ino == entry.st_ino && existing.st_dev == entry.st_dev) {
+        return 1;
+    }
+    return link_replace(path, dest);
+}
+
+int cache_store(const action_cache* cache, const uint8_t key[16], const char* src) {
+    if (!cache || !cache->dir) return 0;
+
+    char path[PATH_MAX];
+    entry_path(cache, key, path, sizeof(path));
+    return link_replace(src, path);
+}
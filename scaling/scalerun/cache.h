@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_CACHE_H
+#define SCALERUN_CACHE_H
+
+#include <stdint.h>
+
+// Content-addressed action cache: <state>/cache/<xx>/<key>, where key is
+// the md5 of an action's command line and the digests of all its inputs.
+typedef struct {
+    char* dir;
+} action_cache;
+
+int cache_init(action_cache* cache, const char* state_dir);
+void cache_cleanup(action_cache* cache);
+
+// Materialize a cached output at 'dest'; returns 1 on a hit
+int cache_lookup(const action_cache* cache, const uint8_t key[16], const char* dest);
+
+// Record 'src' as the output of the action with this key
+int cache_store(const action_cache* cache, const uint8_t key[16], const char* src);
+
+#endif // SCALERUN_CACHE_H
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "common.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Memory helpers
+void* xmalloc(size_t size) {
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+void* xcalloc(size_t num, size_t size) {
+    void* ptr = calloc(num ? num : 1, size ? size : 1);
+    if (!ptr) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+void* xrealloc(void* ptr, size_t size) {
+    void* new_ptr = realloc(ptr, size ? size : 1);
+    if (!new_ptr) {
+        fprintf(stderr, "Error: Memory reallocation failed\n");
+        exit(1);
+    }
+    return new_ptr;
+}
+
+char* xstrdup(const char* str) {
+    size_t len = strlen(str) + 1;
+    char* copy = xmalloc(len);
+    memcpy(copy, str, len);
+    return copy;
+}
+
+// Filesystem helpers
+int join_path(char* buffer, size_t size, const char* dir, const char* name) {
+    int len = snprintf(buffer, size, "%s/%s", dir, name);
+    return len >= 0 && (size_t)len < size;
+}
+
+int make_dirs(const char* path) {
+    if (!path || !*path) return 0;
+
+    char* copy = xstrdup(path);
+    for (char* p = copy + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(copy, 0755) != 0 && errno != EEXIST) {
+            free(copy);
+            return 0;
+        }
+        *p = '/';
+    }
+    int ok = mkdir(copy, 0755) == 0 || errno == EEXIST;
+    free(copy);
+    return ok;
+}
+
+static int remove_entry(const char* path, const struct stat* st, int flag, struct FTW* ftw) {
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    return remove(path);
+}
+
+int remove_tree(const char* path) {
+    if (!path) return 0;
+    struct stat st;
+    if (lstat(path, &st) != 0) return errno == ENOENT;
+    return nftw(path, remove_entry, 16, FTW_DEPTH | FTW_PHYS) == 0;
+}
+
+char* read_file(const char* path, size_t* out_len) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t cap = (size_t)st.st_size + 1;
+    size_t len = 0;
+    char* data = xmalloc(cap);
+    for (;;) {
+        if (len + 1 >= cap) {
+            cap *= 2;
+            data = xrealloc(data, cap);
+        }
+        ssize_t n = read(fd, data + len, cap - len - 1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            free(data);
+            close(fd);
+            return NULL;
+        }
+        if (n == 0) break;
+        len += (size_t)n;
+    }
+    close(fd);
+
+    data[len] = '\0';
+    if (out_len) *out_len = len;
+    return data;
+}
+
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_COMMON_H
+#define SCALERUN_COMMON_H
+
+#include <stddef.h>
+
+// Memory helpers (exit on allocation failure)
+void* xmalloc(size_t size);
+void* xcalloc(size_t num, size_t size);
+void* xrealloc(void* ptr, size_t size);
+char* xstrdup(const char* str);
+
+// Filesystem helpers
+int join_path(char* buffer, size_t size, const char* dir, const char* name);
+int make_dirs(const char* path);
+int remove_tree(const char* path);
+char* read_file(const char* path, size_t* out_len);
+
+// Monotonic clock in seconds
+double now_seconds(void);
+
+#endif // SCALERUN_COMMON_H
@@ -0,0 +1,697 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "graph.h"
+#include "common.h"
+#include <ctype.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Growable array of 32-bit values
+typedef struct {
+    uint32_t* data;
+    size_t len;
+    size_t cap;
+} u32_vec;
+
+static void vec_push(u32_vec* vec, uint32_t value) {
+    if (vec->len == vec->cap) {
+        vec->cap = vec->cap ? vec->cap * 2 : 64;
+        vec->data = xrealloc(vec->data, vec->cap * sizeof(uint32_t));
+    }
+    vec->data[vec->len++] = value;
+}
+
+static uint32_t hash_string(const char* str, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Interning string table; every distinct string is stored once
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    uint32_t* slots;        // offset + 1, 0 = empty
+    uint32_t mask;
+    size_t count;
+} string_table;
+
+static uint32_t strtab_append(string_table* st, const char* str, size_t len) {
+    while (st->len + len + 1 > st->cap) {
+        st->cap = st->cap ? st->cap * 2 : 1 << 16;
+        st->data = xrealloc(st->data, st->cap);
+    }
+    uint32_t offset = (uint32_t)st->len;
+    memcpy(st->data + st->len, str, len);
+    st->data[st->len + len] = '\0';
+    st->len += len + 1;
+    return offset;
+}
+
+static void strtab_grow(string_table* st) {
+    uint32_t new_mask = st->mask ? st->mask * 2 + 1 : 4095;
+    uint32_t* slots = xcalloc((size_t)new_mask + 1, sizeof(uint32_t));
+    for (uint32_t i = 0; st->slots && i <= st->mask; i++) {
+        if (!st->slots[i]) continue;
+        const char* str = st->data + st->slots[i] - 1;
+        uint32_t h = hash_string(str, strlen(str)) & new_mask;
+        while (slots[h]) h = (h + 1) & new_mask;
+        slots[h] = st->slots[i];
+    }
+    free(st->slots);
+    st->slots = slots;
+    st->mask = new_mask;
+}
+
+static uint32_t strtab_intern(string_table* st, const char* str, size_t len) {
+    if (len == 0) return 0;
+    if ((st->count + 1) * 2 > (size_t)st->mask) strtab_grow(st);
+
+    uint32_t h = hash_string(str, len) & st->mask;
+    while (st->slots[h]) {
+        const char* existing = st->data + st->slots[h] - 1;
+        if (strncmp(existing, str, len) == 0 && existing[len] == '\0') {
+            return st->slots[h] - 1;
+        }
+        h = (h + 1) & st->mask;
+    }
+    uint32_t offset = strtab_append(st, str, len);
+    st->slots[h] = offset + 1;
+    st->count++;
+    return offset;
+}
+
+// Target as parsed, before labels are resolved
+typedef struct {
+    uint32_t label;
+    uint8_t kind;
+    uint32_t output;
+    uint32_t command;
+    size_t dep_begin, dep_end;   // into loader.raw_deps (label offsets)
+    size_t src_begin, src_end;   // into loader.raw_srcs (path offsets)
+    uint32_t file;               // BUILD file path, for diagnostics
+} parsed_target;
+
+typedef struct {
+    string_table strings;
+    parsed_target* targets;
+    size_t num_targets;
+    size_t cap_targets;
+    u32_vec raw_deps;
+    u32_vec raw_srcs;
+    size_t num_build_files;
+} loader;
+
+// BUILD file lexer: just enough Python syntax for target declarations
+enum { TOK_EOF, TOK_IDENT, TOK_STRING, TOK_PUNCT, TOK_ERROR };
+
+typedef struct {
+    const char* pos;
+    const char* end;
+    int line;
+    int type;
+    const char* text;
+    size_t len;
+    char* scratch;              // unescaped string literal
+    size_t scratch_cap;
+} lexer;
+
+static void lex_next(lexer* lx) {
+    for (;;) {
+        while (lx->pos < lx->end && isspace((unsigned char)*lx->pos)) {
+            if (*lx->pos == '\n') lx->line++;
+            lx->pos++;
+        }
+        if (lx->pos < lx->end && *lx->pos == '#') {
+            while (lx->pos < lx->end && *lx->pos != '\n') lx->pos++;
+            continue;
+        }
+        break;
+    }
+
+    if (lx->pos >= lx->end) {
+        lx->type = TOK_EOF;
+        return;
+    }
+
+    char c = *lx->pos;
+    if (isalnum((unsigned char)c) || c == '_' || c == '-' || c == '.') {
+        lx->text = lx->pos;
+        while (lx->pos < lx->end && (isalnum((unsigned char)*lx->pos) || *lx->pos == '_' ||
+                                     *lx->pos == '-' || *lx->pos == '.')) {
+            lx->pos++;
+        }
+        lx->len = (size_t)(lx->pos - lx->text);
+        lx->type = TOK_IDENT;
+        return;
+    }
+
+    if (c == '"' || c == '\'') {
+        char quote = c;
+        size_t len = 0;
+        lx->pos++;
+        while (lx->pos < lx->end && *lx->pos != quote) {
+            char ch = *lx->pos++;
+            if (ch == '\n') {
+                lx->type = TOK_ERROR;
+                return;
+            }
+            if (ch == '\\' && lx->pos < lx->end) {
+                ch = *lx->pos++;
+                if (ch == 'n') ch = '\n';
+                else if (ch == 't') ch = '\t';
+            }
+            if (len + 1 >= lx->scratch_cap) {
+                lx->scratch_cap = lx->scratch_cap ? lx->scratch_cap * 2 : 256;
+                lx->scratch = xrealloc(lx->scratch, lx->scratch_cap);
+            }
+            lx->scratch[len++] = ch;
+        }
+        if (lx->pos >= lx->end) {
+            lx->type = TOK_ERROR;
+            return;
+        }
+        lx->pos++;
+        if (!lx->scratch) lx->scratch = xcalloc(1, lx->scratch_cap = 256);
+        lx->scratch[len] = '\0';
+        lx->text = lx->scratch;
+        lx->len = len;
+        lx->type = TOK_STRING;
+        return;
+    }
+
+    lx->text = lx->pos++;
+    lx->len = 1;
+    lx->type = TOK_PUNCT;
+}
+
+static int lex_is(const lexer* lx, char punct) {
+    return lx->type == TOK_PUNCT && lx->text[0] == punct;
+}
+
+static int lex_ident_is(const lexer* lx, const char* ident) {
+    return lx->type == TOK_IDENT && strlen(ident) == lx->len && memcmp(lx->text, ident, lx->len) == 0;
+}
+
+// Parse one value; string literals are appended to 'out' when non-NULL
+static int parse_value(lexer* lx, loader* ld, u32_vec* out) {
+    if (lx->type == TOK_STRING) {
+        if (out) vec_push(out, strtab_intern(&ld->strings, lx->text, lx->len));
+        lex_next(lx);
+        return 1;
+    }
+
+    if (lx->type == TOK_IDENT) {
+        lex_next(lx);
+        if (!lex_is(lx, '(')) return 1;
+    }
+
+    if (lex_is(lx, '[') || lex_is(lx, '(') || lex_is(lx, '{')) {
+        char close = lx->text[0] == '[' ? ']' : lx->text[0] == '(' ? ')' : '}';
+        lex_next(lx);
+        while (!lex_is(lx, close)) {
+            if (lx->type == TOK_EOF || lx->type == TOK_ERROR) return 0;
+            if (lex_is(lx, ',') || lex_is(lx, ':') || lex_is(lx, '=')) {
+                lex_next(lx);
+                continue;
+            }
+            if (!parse_value(lx, ld, out)) return 0;
+        }
+        lex_next(lx);
+        return 1;
+    }
+
+    return 0;
+}
+
+static uint32_t normalize_label(loader* ld, const char* pkg, uint32_t raw_offset) {
+    const char* raw = ld->strings.data + raw_offset;
+    if (raw[0] == '/' && raw[1] == '/') raw += 2;
+
+    const char* colon = strrchr(raw, ':');
+    size_t pkg_len;
+    const char* name;
+    char buffer[4096];
+
+    if (!colon) {
+        // "path/to/pkg" is shorthand for "path/to/pkg:pkg"
+        const char* slash = strrchr(raw, '/');
+        pkg_len = strlen(raw);
+        name = slash ? slash + 1 : raw;
+    } else if (colon == raw) {
+        raw = pkg;
+        pkg_len = strlen(pkg);
+        name = colon + 1;
+    } else {
+        pkg_len = (size_t)(colon - raw);
+        name = colon + 1;
+    }
+
+    int len = snprintf(buffer, sizeof(buffer), "%.*s:%s", (int)pkg_len, raw, name);
+    if (len < 0 || (size_t)len >= sizeof(buffer)) return 0;
+    return strtab_intern(&ld->strings, buffer, (size_t)len);
+}
+
+static uint32_t package_path(loader* ld, const char* pkg, uint32_t file_offset) {
+    const char* file = ld->strings.data + file_offset;
+    if (!*pkg) return file_offset;
+
+    char buffer[4096];
+    int len = snprintf(buffer, sizeof(buffer), "%s/%s", pkg, file);
+    if (len < 0 || (size_t)len >= sizeof(buffer)) return 0;
+    return strtab_intern(&ld->strings, buffer, (size_t)len);
+}
+
+static int parse_target(lexer* lx, loader* ld, const char* path, const char* pkg, uint32_t file) {
+    uint8_t kind = TARGET_OTHER;
+    if (lex_ident_is(lx, "shell_sources")) kind = TARGET_SOURCES;
+    else if (lex_ident_is(lx, "adhoc_tool")) kind = TARGET_TOOL;
+    else if (lex_ident_is(lx, "run_shell_command")) kind = TARGET_COMMAND;
+
+    lex_next(lx);
+    if (!lex_is(lx, '(')) {
+        fprintf(stderr, "Error: %s:%d: expected '(' after target type\n", path, lx->line);
+        return 0;
+    }
+    lex_next(lx);
+
+    u32_vec name = {0}, deps = {0}, srcs = {0}, outputs = {0}, command = {0};
+    int ok = 1;
+    while (ok && !lex_is(lx, ')')) {
+        if (lex_is(lx, ',')) {
+            lex_next(lx);
+            continue;
+        }
+        if (lx->type != TOK_IDENT) {
+            ok = 0;
+            break;
+        }
+
+        u32_vec* out = NULL;
+        if (lex_ident_is(lx, "name")) out = &name;
+        else if (lex_ident_is(lx, "execution_dependencies")) out = &deps;
+        else if (lex_ident_is(lx, "sources")) out = &srcs;
+        else if (lex_ident_is(lx, "output_files")) out = &outputs;
+        else if (lex_ident_is(lx, "command")) out = &command;
+
+        lex_next(lx);
+        if (!lex_is(lx, '=')) {
+            ok = 0;
+            break;
+        }
+        lex_next(lx);
+        ok = parse_value(lx, ld, out);
+    }
+    if (ok) lex_next(lx);
+
+    if (ok && name.len != 1) {
+        fprintf(stderr, "Error: %s:%d: target needs exactly one name\n", path, lx->line);
+        ok = 0;
+    } else if (ok && kind == TARGET_TOOL && outputs.len != 1) {
+        fprintf(stderr, "Error: %s:%d: adhoc_tool must declare exactly one output file\n", path, lx->line);
+        ok = 0;
+    } else if (!ok) {
+        fprintf(stderr, "Error: %s:%d: malformed target declaration\n", path, lx->line);
+    }
+
+    if (ok) {
+        if (ld->num_targets == ld->cap_targets) {
+            ld->cap_targets = ld->cap_targets ? ld->cap_targets * 2 : 1024;
+            ld->targets = xrealloc(ld->targets, ld->cap_targets * sizeof(parsed_target));
+        }
+        parsed_target* t = &ld->targets[ld->num_targets++];
+        char label[4096];
+        snprintf(label, sizeof(label), "%s:%s", pkg, ld->strings.data + name.data[0]);
+        t->label = strtab_intern(&ld->strings, label, strlen(label));
+        t->kind = kind;
+        t->output = kind == TARGET_TOOL ? outputs.data[0] : 0;
+        t->command = kind == TARGET_COMMAND && command.len ? command.data[0] : 0;
+        t->file = file;
+
+        t->dep_begin = ld->raw_deps.len;
+        for (size_t i = 0; i < deps.len; i++) {
+            vec_push(&ld->raw_deps, normalize_label(ld, pkg, deps.data[i]));
+        }
+        t->dep_end = ld->raw_deps.len;
+
+        t->src_begin = ld->raw_srcs.len;
+        for (size_t i = 0; i < srcs.len; i++) {
+            vec_push(&ld->raw_srcs, package_path(ld, pkg, srcs.data[i]));
+        }
+        t->src_end = ld->raw_srcs.len;
+    }
+
+    free(name.data);
+    free(deps.data);
+    free(srcs.data);
+    free(outputs.data);
+    free(command.data);
+    return ok;
+}
+
+static int parse_build_file(loader* ld, const char* root, const char* pkg) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s%sBUILD", root, pkg, *pkg ? "/" : "");
+
+    size_t len;
+    char* data = read_file(path, &len);
+    if (!data) {
+        fprintf(stderr, "Error: Cannot read %s\n", path);
+        return 0;
+    }
+
+    char rel[4096];
+    snprintf(rel, sizeof(rel), "%s%sBUILD", pkg, *pkg ? "/" : "");
+    uint32_t file = strtab_intern(&ld->strings, rel, strlen(rel));
+
+    lexer lx = {data, data + len, 1, TOK_EOF, NULL, 0, NULL, 0};
+    lex_next(&lx);
+
+    int ok = 1;
+    while (ok && lx.type != TOK_EOF) {
+        if (lx.type != TOK_IDENT) {
+            fprintf(stderr, "Error: %s:%d: expected a target declaration\n", path, lx.line);
+            ok = 0;
+            break;
+        }
+        ok = parse_target(&lx, ld, path, pkg, file);
+    }
+
+    free(lx.scratch);
+    free(data);
+    ld->num_build_files++;
+    return ok;
+}
+
+static int compare_strings(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static void list_push(char*** list, size_t* count, size_t* cap, char* str) {
+    if (*count == *cap) {
+        *cap = *cap ? *cap * 2 : 1024;
+        *list = xrealloc(*list, *cap * sizeof(char*));
+    }
+    (*list)[(*count)++] = str;
+}
+
+// Collect package directories containing a BUILD file, and every directory
+// walked to find them, relative to root
+static void find_packages(const char* root, const char* rel, build_tree* tree, size_t* cap_dirs,
+                          size_t* cap_packages) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s%s%s", root, *rel ? "/" : "", rel);
+
+    DIR* dir = opendir(path);
+    if (!dir) return;
+    list_push(&tree->dirs, &tree->num_dirs, cap_dirs, xstrdup(rel));
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+
+        int is_dir = entry->d_type == DT_DIR;
+        int is_file = entry->d_type == DT_REG;
+        if (entry->d_type == DT_UNKNOWN) {
+            char full[4096];
+            struct stat st;
+            if (!join_path(full, sizeof(full), path, entry->d_name) || lstat(full, &st) != 0) continue;
+            is_dir = S_ISDIR(st.st_mode);
+            is_file = S_ISREG(st.st_mode);
+        }
+
+        if (is_file && strcmp(entry->d_name, "BUILD") == 0) {
+            list_push(&tree->packages, &tree->num_packages, cap_packages, xstrdup(rel));
+        } else if (is_dir) {
+            size_t len = strlen(rel) + strlen(entry->d_name) + 2;
+            char* child = xmalloc(len);
+            snprintf(child, len, "%s%s%s", rel, *rel ? "/" : "", entry->d_name);
+            find_packages(root, child, tree, cap_dirs, cap_packages);
+            free(child);
+        }
+    }
+    closedir(dir);
+}
+
+int graph_scan_tree(const char* root, build_tree* tree) {
+    memset(tree, 0, sizeof(*tree));
+    if (!root) return 0;
+    size_t cap_dirs = 0, cap_packages = 0;
+    find_packages(root, "", tree, &cap_dirs, &cap_packages);
+    if (tree->num_packages == 0) {
+        fprintf(stderr, "Error: No BUILD files found under %s\n", root);
+        graph_tree_free(tree);
+        return 0;
+    }
+    qsort(tree->dirs, tree->num_dirs, sizeof(char*), compare_strings);
+    qsort(tree->packages, tree->num_packages, sizeof(char*), compare_strings);
+    return 1;
+}
+
+void graph_tree_free(build_tree* tree) {
+    if (!tree) return;
+    for (size_t i = 0; i < tree->num_dirs; i++) free(tree->dirs[i]);
+    for (size_t i = 0; i < tree->num_packages; i++) free(tree->packages[i]);
+    free(tree->dirs);
+    free(tree->packages);
+    memset(tree, 0, sizeof(*tree));
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Depth-first walk in target order; an edge back to a target that is
+// still on the stack closes a cycle and is dropped with a warning, the
+// same way make handles circular prerequisites.
+static void break_cycles(build_graph* g) {
+    uint32_t n = g->num_targets;
+    uint8_t* state = xcalloc(n, sizeof(uint8_t));     // 0 new, 1 on stack, 2 done
+    uint32_t* stack = xmalloc((size_t)n * sizeof(uint32_t));
+    uint32_t* next_edge = xmalloc((size_t)n * sizeof(uint32_t));
+    uint8_t* dropped = xcalloc(g->dep_index[n] ? g->dep_index[n] : 1, sizeof(uint8_t));
+
+    for (uint32_t root = 0; root < n; root++) {
+        if (state[root]) continue;
+        size_t depth = 0;
+        stack[depth++] = root;
+        state[root] = 1;
+        next_edge[root] = g->dep_index[root];
+
+        while (depth > 0) {
+            uint32_t t = stack[depth - 1];
+            if (next_edge[t] == g->dep_index[t + 1]) {
+                state[t] = 2;
+                depth--;
+                continue;
+            }
+            uint32_t edge = next_edge[t]++;
+            uint32_t dep = g->deps[edge];
+            if (state[dep] == 1) {
+                fprintf(stderr, "Warning: Circular //%s <- //%s dependency dropped\n", graph_str(g, g->label[t]),
+                        graph_str(g, g->label[dep]));
+                dropped[edge] = 1;
+                g->dropped_edges++;
+            } else if (state[dep] == 0) {
+                state[dep] = 1;
+                next_edge[dep] = g->dep_index[dep];
+                stack[depth++] = dep;
+            }
+        }
+    }
+
+    if (g->dropped_edges) {
+        uint32_t out = 0;
+        for (uint32_t t = 0; t < n; t++) {
+            uint32_t begin = g->dep_index[t], end = g->dep_index[t + 1];
+            g->dep_index[t] = out;
+            for (uint32_t i = begin; i < end; i++) {
+                if (!dropped[i]) g->deps[out++] = g->deps[i];
+            }
+        }
+        g->dep_index[n] = out;
+    }
+
+    free(state);
+    free(stack);
+    free(next_edge);
+    free(dropped);
+}
+
+static void build_lookup(build_graph* g) {
+    uint32_t cap = 1024;
+    while (cap < g->num_targets * 2) cap *= 2;
+    g->lookup_mask = cap - 1;
+    g->lookup = xcalloc(cap, sizeof(uint32_t));
+
+    for (uint32_t t = 0; t < g->num_targets; t++) {
+        const char* label = graph_str(g, g->label[t]);
+        uint32_t h = hash_string(label, strlen(label)) & g->lookup_mask;
+        while (g->lookup[h]) h = (h + 1) & g->lookup_mask;
+        g->lookup[h] = t + 1;
+    }
+}
+
+static void graph_build_reverse(build_graph* g) {
+    uint32_t n = g->num_targets;
+    uint32_t num_edges = g->dep_index[n];
+
+    g->rdep_index = xcalloc((size_t)n + 1, sizeof(uint32_t));
+    g->rdeps = xmalloc((size_t)num_edges * sizeof(uint32_t));
+    for (uint32_t i = 0; i < num_edges; i++) g->rdep_index[g->deps[i] + 1]++;
+    for (uint32_t t = 0; t < n; t++) g->rdep_index[t + 1] += g->rdep_index[t];
+
+    uint32_t* fill = xmalloc((size_t)n * sizeof(uint32_t));
+    memcpy(fill, g->rdep_index, (size_t)n * sizeof(uint32_t));
+    for (uint32_t t = 0; t < n; t++) {
+        for (uint32_t i = g->dep_index[t]; i < g->dep_index[t + 1]; i++) {
+            g->rdeps[fill[g->deps[i]]++] = t;
+        }
+    }
+    free(fill);
+}
+
+build_graph* graph_load(const char* root) {
+    build_tree tree;
+    if (!graph_scan_tree(root, &tree)) return NULL;
+    build_graph* g = graph_load_tree(root, &tree);
+    graph_tree_free(&tree);
+    return g;
+}
+
+build_graph* graph_load_tree(const char* root, const build_tree* tree) {
+    if (!root || !tree) return NULL;
+
+    loader ld = {0};
+    strtab_append(&ld.strings, "", 0);
+
+    int ok = 1;
+    for (size_t i = 0; ok && i < tree->num_packages; i++) ok = parse_build_file(&ld, root, tree->packages[i]);
+
+    build_graph* g = xcalloc(1, sizeof(build_graph));
+    g->num_targets = (uint32_t)ld.num_targets;
+    g->num_build_files = ld.num_build_files;
+    g->raw_edges = ld.raw_deps.len;
+    g->label = xmalloc(ld.num_targets * sizeof(uint32_t));
+    g->kind = xmalloc(ld.num_targets * sizeof(uint8_t));
+    g->output = xmalloc(ld.num_targets * sizeof(uint32_t));
+    g->command = xmalloc(ld.num_targets * sizeof(uint32_t));
+    for (size_t t = 0; t < ld.num_targets; t++) {
+        g->label[t] = ld.targets[t].label;
+        g->kind[t] = ld.targets[t].kind;
+        g->output[t] = ld.targets[t].output;
+        g->command[t] = ld.targets[t].command;
+    }
+
+    // Everything referenced by offset is in the table now; hand it over
+    g->strtab = ld.strings.data;
+    g->strtab_len = ld.strings.len;
+    free(ld.strings.slots);
+    build_lookup(g);
+
+    // Resolve, sort and de-duplicate dependency edges
+    g->dep_index = xcalloc((size_t)g->num_targets + 1, sizeof(uint32_t));
+    g->deps = xmalloc((ld.raw_deps.len ? ld.raw_deps.len : 1) * sizeof(uint32_t));
+    g->src_index = xcalloc((size_t)g->num_targets + 1, sizeof(uint32_t));
+    g->srcs = xmalloc((ld.raw_srcs.len ? ld.raw_srcs.len : 1) * sizeof(uint32_t));
+
+    uint32_t num_deps = 0, num_srcs = 0;
+    for (uint32_t t = 0; ok && t < g->num_targets; t++) {
+        const parsed_target* pt = &ld.targets[t];
+        uint32_t begin = num_deps;
+        for (size_t i = pt->dep_begin; i < pt->dep_end; i++) {
+            const char* label = graph_str(g, ld.raw_deps.data[i]);
+            int dep = ld.raw_deps.data[i] ? graph_find(g, label) : -1;
+            if (dep < 0) {
+                fprintf(stderr, "Error: %s: //%s depends on unknown target //%s\n",
+                        graph_str(g, pt->file), graph_str(g, pt->label), label);
+                ok = 0;
+                break;
+            }
+            g->deps[num_deps++] = (uint32_t)dep;
+        }
+
+        qsort(g->deps + begin, num_deps - begin, sizeof(uint32_t), compare_u32);
+        uint32_t unique = begin;
+        for (uint32_t i = begin; i < num_deps; i++) {
+            if (unique == begin || g->deps[unique - 1] != g->deps[i]) g->deps[unique++] = g->deps[i];
+        }
+        num_deps = unique;
+        g->dep_index[t + 1] = num_deps;
+
+        for (size_t i = pt->src_begin; i < pt->src_end; i++) g->srcs[num_srcs++] = ld.raw_srcs.data[i];
+        g->src_index[t + 1] = num_srcs;
+    }
+
+    free(ld.targets);
+    free(ld.raw_deps.data);
+    free(ld.raw_srcs.data);
+
+    if (ok) {
+        break_cycles(g);
+        graph_build_reverse(g);
+    }
+    if (!ok) {
+        graph_free(g);
+        return NULL;
+    }
+    return g;
+}
+
+void graph_free(build_graph* graph) {
+    if (!graph) return;
+    if (graph->mapping) {
+        // Precompiled: every array points into the mapping
+        munmap(graph->mapping, graph->mapping_len);
+        free(graph);
+        return;
+    }
+    free(graph->strtab);
+    free(graph->label);
+    free(graph->kind);
+    free(graph->output);
+    free(graph->command);
+    free(graph->dep_index);
+    free(graph->deps);
+    free(graph->rdep_index);
+    free(graph->rdeps);
+    free(graph->src_index);
+    free(graph->srcs);
+    free(graph->lookup);
+    free(graph);
+}
+
+const char* graph_str(const build_graph* graph, uint32_t offset) {
+    if (!graph || offset >= graph->strtab_len) return "";
+    return graph->strtab + offset;
+}
+
+int graph_find(const build_graph* graph, const char* label) {
+    if (!graph || !label) return -1;
+    if (label[0] == '/' && label[1] == '/') label += 2;
+
+    uint32_t h = hash_string(label, strlen(label)) & graph->lookup_mask;
+    while (graph->lookup[h]) {
+        uint32_t t = graph->lookup[h] - 1;
+        if (strcmp(graph_str(graph, graph->label[t]), label) == 0) return (int)t;
+        h = (h + 1) & graph->lookup_mask;
+    }
+    return -1;
+}
+
+size_t graph_num_edges(const build_graph* graph) {
+    return graph ? graph->dep_index[graph->num_targets] : 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_GRAPH_H
+#define SCALERUN_GRAPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Target kinds understood by the BUILD loader
+enum {
+    TARGET_SOURCES = 0,   // shell_sources(): checked-in files
+    TARGET_TOOL = 1,      // adhoc_tool(): runs the build script, produces one output file
+    TARGET_COMMAND = 2,   // run_shell_command(): runs a command over its dependencies
+    TARGET_OTHER = 3      // system_binary() and anything else: nothing to build
+};
+
+// Compact target graph. All names live in one string table and are
+// referenced by offset; offset 0 is the empty string. Edges are stored
+// as CSR arrays: the dependencies of target t are
+// deps[dep_index[t]] .. deps[dep_index[t + 1] - 1], de-duplicated and sorted.
+typedef struct {
+    char* strtab;
+    size_t strtab_len;
+
+    uint32_t num_targets;
+    uint32_t* label;        // "pkg:name"
+    uint8_t* kind;
+    uint32_t* output;       // output file name of a TARGET_TOOL, else 0
+    uint32_t* command;      // shell command of a TARGET_COMMAND, else 0
+
+    uint32_t* dep_index;    // num_targets + 1 entries
+    uint32_t* deps;
+    uint32_t* rdep_index;   // reverse edges, same layout
+    uint32_t* rdeps;
+    uint32_t* src_index;    // source paths relative to the root
+    uint32_t* srcs;
+
+    uint32_t lookup_mask;   // open-addressed label -> target + 1 table
+    uint32_t* lookup;
+
+    size_t num_build_files;
+    size_t raw_edges;       // execution_dependencies entries before de-duplication
+    size_t dropped_edges;   // edges removed to break dependency cycles
+
+    void* mapping;          // set when the arrays live in a precompiled graph file
+    size_t mapping_len;
+} build_graph;
+
+// Layout of a BUILD tree, paths relative to the root, sorted
+typedef struct {
+    char** dirs;            // every directory walked, "" for the root
+    size_t num_dirs;
+    char** packages;        // directories holding a BUILD file
+    size_t num_packages;
+} build_tree;
+
+int graph_scan_tree(const char* root, build_tree* tree);
+void graph_tree_free(build_tree* tree);
+
+// Loading
+build_graph* graph_load(const char* root);
+build_graph* graph_load_tree(const char* root, const build_tree* tree);
+void graph_free(build_graph* graph);
+
+// Queries
+const char* graph_str(const build_graph* graph, uint32_t offset);
+int graph_find(const build_graph* graph, const char* label);
+size_t graph_num_edges(const build_graph* graph);
+
+#endif // SCALERUN_GRAPH_H
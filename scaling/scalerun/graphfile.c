@@ -0,0 +1,401 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "graphfile.h"
+#include "common.h"
+#include "md5.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GRAPH_FILE_MAGIC "SCGRAPH"
+#define GRAPH_FILE_VERSION 1
+
+enum {
+    SECTION_STRTAB,
+    SECTION_LABEL,
+    SECTION_KIND,
+    SECTION_OUTPUT,
+    SECTION_COMMAND,
+    SECTION_DEP_INDEX,
+    SECTION_DEPS,
+    SECTION_RDEP_INDEX,
+    SECTION_RDEPS,
+    SECTION_SRC_INDEX,
+    SECTION_SRCS,
+    SECTION_LOOKUP,
+    SECTION_NAMES,          // manifest paths; offset 0 is the absolute root
+    SECTION_DIRS,
+    SECTION_PACKAGES,
+    NUM_SECTIONS
+};
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_targets;
+    uint32_t num_edges;
+    uint32_t num_srcs;
+    uint32_t lookup_mask;
+    uint32_t num_dirs;
+    uint32_t num_packages;
+    uint32_t reserved;
+    uint64_t strtab_len;
+    uint64_t names_len;
+    uint64_t num_build_files;
+    uint64_t raw_edges;
+    uint64_t dropped_edges;
+    uint64_t file_size;
+    uint64_t offset[NUM_SECTIONS];
+    uint64_t length[NUM_SECTIONS];
+} graph_file_header;
+
+typedef struct {
+    uint64_t name;
+    int64_t mtime_ns;
+} dir_record;
+
+typedef struct {
+    uint64_t name;
+    int64_t mtime_ns;
+    uint64_t size;
+    uint8_t md5[16];
+} package_record;
+
+static int64_t stat_mtime(const struct stat* st) {
+    return (int64_t)st->st_mtim.tv_sec * 1000000000 + st->st_mtim.tv_nsec;
+}
+
+static int build_file_path(char* buffer, size_t size, const char* root, const char* pkg) {
+    int n = snprintf(buffer, size, "%s/%s%sBUILD", root, pkg, *pkg ? "/" : "");
+    return n > 0 && (size_t)n < size;
+}
+
+static int dir_path(char* buffer, size_t size, const char* root, const char* dir) {
+    int n = snprintf(buffer, size, "%s%s%s", root, *dir ? "/" : "", dir);
+    return n > 0 && (size_t)n < size;
+}
+
+// Stamp every directory and BUILD file of 'tree'. Taken before parsing,
+// so an edit racing with the compile is caught by the next check.
+static int stamp_tree(const char* root, const build_tree* tree, dir_record* dirs, package_record* packages) {
+    char path[PATH_MAX];
+    struct stat st;
+    for (size_t i = 0; i < tree->num_dirs; i++) {
+        if (!dir_path(path, sizeof(path), root, tree->dirs[i]) || stat(path, &st) != 0) return 0;
+        dirs[i].mtime_ns = stat_mtime(&st);
+    }
+    for (size_t i = 0; i < tree->num_packages; i++) {
+        if (!build_file_path(path, sizeof(path), root, tree->packages[i]) || stat(path, &st) != 0 ||
+            !md5_file(path, packages[i].md5)) {
+            return 0;
+        }
+        packages[i].mtime_ns = stat_mtime(&st);
+        packages[i].size = (uint64_t)st.st_size;
+    }
+    return 1;
+}
+
+static int write_padded(FILE* file, const void* data, size_t len, uint64_t* pos) {
+    static const char zeros[8] = {0};
+    if (len && fwrite(data, 1, len, file) != len) return 0;
+    *pos += len;
+    size_t pad = (size_t)((8 - (*pos & 7)) & 7);
+    if (pad && fwrite(zeros, 1, pad, file) != pad) return 0;
+    *pos += pad;
+    return 1;
+}
+
+static int write_graph_file(const char* path, const char* root, const build_graph* g, const build_tree* tree,
+                            dir_record* dirs, package_record* packages) {
+    // Manifest paths: the root first, then directory and package names
+    size_t names_len = strlen(root) + 1;
+    for (size_t i = 0; i < tree->num_dirs; i++) names_len += strlen(tree->dirs[i]) + 1;
+    for (size_t i = 0; i < tree->num_packages; i++) names_len += strlen(tree->packages[i]) + 1;
+    char* names = xmalloc(names_len);
+    char* out = stpcpy(names, root) + 1;
+    for (size_t i = 0; i < tree->num_dirs; i++) {
+        dirs[i].name = (uint64_t)(out - names);
+        out = stpcpy(out, tree->dirs[i]) + 1;
+    }
+    for (size_t i = 0; i < tree->num_packages; i++) {
+        packages[i].name = (uint64_t)(out - names);
+        out = stpcpy(out, tree->packages[i]) + 1;
+    }
+
+    uint32_t n = g->num_targets;
+    const void* data[NUM_SECTIONS] = {
+        g->strtab, g->label, g->kind, g->output, g->command, g->dep_index, g->deps, g->rdep_index, g->rdeps,
+        g->src_index, g->srcs, g->lookup, names, dirs, packages,
+    };
+    uint64_t length[NUM_SECTIONS] = {
+        g->strtab_len,
+        n * sizeof(uint32_t),
+        n,
+        n * sizeof(uint32_t),
+        n * sizeof(uint32_t),
+        (n + 1) * sizeof(uint32_t),
+        g->dep_index[n] * sizeof(uint32_t),
+        (n + 1) * sizeof(uint32_t),
+        g->rdep_index[n] * sizeof(uint32_t),
+        (n + 1) * sizeof(uint32_t),
+        g->src_index[n] * sizeof(uint32_t),
+        ((uint64_t)g->lookup_mask + 1) * sizeof(uint32_t),
+        names_len,
+        tree->num_dirs * sizeof(dir_record),
+        tree->num_packages * sizeof(package_record),
+    };
+
+    graph_file_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC));
+    header.version = GRAPH_FILE_VERSION;
+    header.num_targets = n;
+    header.num_edges = g->dep_index[n];
+    header.num_srcs = g->src_index[n];
+    header.lookup_mask = g->lookup_mask;
+    header.num_dirs = (uint32_t)tree->num_dirs;
+    header.num_packages = (uint32_t)tree->num_packages;
+    header.strtab_len = g->strtab_len;
+    header.names_len = names_len;
+    header.num_build_files = g->num_build_files;
+    header.raw_edges = g->raw_edges;
+    header.dropped_edges = g->dropped_edges;
+
+    uint64_t pos = sizeof(header);
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        header.offset[i] = pos;
+        header.length[i] = length[i];
+        pos += (length[i] + 7) & ~(uint64_t)7;
+    }
+    header.file_size = pos;
+
+    char tmp[PATH_MAX];
+    int ok = snprintf(tmp, sizeof(tmp), "%s.tmp", path) < (int)sizeof(tmp);
+    FILE* file = ok ? fopen(tmp, "wb") : NULL;
+    if (!file) {
+        free(names);
+        return 0;
+    }
+
+    pos = 0;
+    ok = write_padded(file, &header, sizeof(header), &pos);
+    for (int i = 0; ok && i < NUM_SECTIONS; i++) ok = write_padded(file, data[i], (size_t)length[i], &pos);
+    ok = fclose(file) == 0 && ok;
+    if (ok) ok = rename(tmp, path) == 0;
+    if (!ok) unlink(tmp);
+    free(names);
+    return ok;
+}
+
+static build_graph* map_graph_file(const char* path, const graph_file_header** out_header) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(graph_file_header)) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    const graph_file_header* h = mapping;
+    int ok = memcmp(h->magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) == 0 &&
+             h->version == GRAPH_FILE_VERSION && h->file_size == size && h->num_targets > 0;
+    for (int i = 0; ok && i < NUM_SECTIONS; i++) {
+        ok = h->offset[i] % 8 == 0 && h->offset[i] <= size && h->length[i] <= size - h->offset[i];
+    }
+    uint64_t n = ok ? h->num_targets : 0;
+    ok = ok && h->length[SECTION_STRTAB] == h->strtab_len && h->length[SECTION_LABEL] == n * sizeof(uint32_t) &&
+         h->length[SECTION_KIND] == n && h->length[SECTION_DEP_INDEX] == (n + 1) * sizeof(uint32_t) &&
+         h->length[SECTION_RDEP_INDEX] == (n + 1) * sizeof(uint32_t) &&
+         h->length[SECTION_SRC_INDEX] == (n + 1) * sizeof(uint32_t) &&
+         h->length[SECTION_DEPS] == (uint64_t)h->num_edges * sizeof(uint32_t) &&
+         h->length[SECTION_RDEPS] == (uint64_t)h->num_edges * sizeof(uint32_t) &&
+         h->length[SECTION_SRCS] == (uint64_t)h->num_srcs * sizeof(uint32_t) &&
+         h->length[SECTION_LOOKUP] == ((uint64_t)h->lookup_mask + 1) * sizeof(uint32_t) &&
+         h->length[SECTION_NAMES] == h->names_len &&
+         h->length[SECTION_DIRS] == (uint64_t)h->num_dirs * sizeof(dir_record) &&
+         h->length[SECTION_PACKAGES] == (uint64_t)h->num_packages * sizeof(package_record);
+    if (!ok) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    char* base = mapping;
+    build_graph* g = xcalloc(1, sizeof(build_graph));
+    g->mapping = mapping;
+    g->mapping_len = size;
+    g->strtab = base + h->offset[SECTION_STRTAB];
+    g->strtab_len = h->strtab_len;
+    g->num_targets = h->num_targets;
+    g->label = (uint32_t*)(base + h->offset[SECTION_LABEL]);
+    g->kind = (uint8_t*)(base + h->offset[SECTION_KIND]);
+    g->output = (uint32_t*)(base + h->offset[SECTION_OUTPUT]);
+    g->command = (uint32_t*)(base + h->offset[SECTION_COMMAND]);
+    g->dep_index = (uint32_t*)(base + h->offset[SECTION_DEP_INDEX]);
+    g->deps = (uint32_t*)(base + h->offset[SECTION_DEPS]);
+    g->rdep_index = (uint32_t*)(base + h->offset[SECTION_RDEP_INDEX]);
+    g->rdeps = (uint32_t*)(base + h->offset[SECTION_RDEPS]);
+    g->src_index = (uint32_t*)(base + h->offset[SECTION_SRC_INDEX]);
+    g->srcs = (uint32_t*)(base + h->offset[SECTION_SRCS]);
+    g->lookup_mask = h->lookup_mask;
+    g->lookup = (uint32_t*)(base + h->offset[SECTION_LOOKUP]);
+    g->num_build_files = (size_t)h->num_build_files;
+    g->raw_edges = (size_t)h->raw_edges;
+    g->dropped_edges = (size_t)h->dropped_edges;
+    if (out_header) *out_header = h;
+    return g;
+}
+
+build_graph* graph_file_map(const char* path) {
+    return path ? map_graph_file(path, NULL) : NULL;
+}
+
+// Parse the tree and write a fresh file; the parsed graph is returned as is
+static build_graph* compile_graph_file(const char* root, const char* path, build_tree* tree) {
+    dir_record* dirs = xcalloc(tree->num_dirs ? tree->num_dirs : 1, sizeof(dir_record));
+    package_record* packages = xcalloc(tree->num_packages, sizeof(package_record));
+    int stamped = stamp_tree(root, tree, dirs, packages);
+
+    build_graph* g = graph_load_tree(root, tree);
+    if (g && (!stamped || !write_graph_file(path, root, g, tree, dirs, packages))) {
+        fprintf(stderr, "Warning: Cannot write the precompiled graph %s\n", path);
+    }
+    free(dirs);
+    free(packages);
+    return g;
+}
+
+build_graph* graph_file_open(const char* root, const char* path, graph_file_status* status) {
+    graph_file_status local;
+    if (!status) status = &local;
+    memset(status, 0, sizeof(*status));
+    if (!root || !path) return NULL;
+
+    char abs_root[PATH_MAX];
+    if (!realpath(root, abs_root)) {
+        fprintf(stderr, "Error: Cannot resolve %s\n", root);
+        return NULL;
+    }
+
+    const graph_file_header* h = NULL;
+    build_graph* g = map_graph_file(path, &h);
+    const char* names = g ? (const char*)g->mapping + h->offset[SECTION_NAMES] : NULL;
+    if (!g) status->reason = "no usable precompiled graph";
+    else if (strcmp(names, abs_root) != 0) status->reason = "compiled for another root";
+
+    // Check the manifest: a directory whose mtime moved may have gained or
+    // lost a BUILD file; a BUILD file whose mtime moved is re-hashed
+    dir_record* dirs = NULL;
+    package_record* packages = NULL;
+    int listing_changed = 0;
+    char file[PATH_MAX];
+    struct stat st;
+    if (!status->reason) {
+        dirs = xmalloc((h->num_dirs ? h->num_dirs : 1) * sizeof(dir_record));
+        packages = xmalloc((h->num_packages ? h->num_packages : 1) * sizeof(package_record));
+        memcpy(dirs, (const char*)g->mapping + h->offset[SECTION_DIRS], h->length[SECTION_DIRS]);
+        memcpy(packages, (const char*)g->mapping + h->offset[SECTION_PACKAGES], h->length[SECTION_PACKAGES]);
+
+        for (uint32_t i = 0; i < h->num_dirs; i++) {
+            if (!dir_path(file, sizeof(file), abs_root, names + dirs[i].name) || stat(file, &st) != 0 ||
+                stat_mtime(&st) != dirs[i].mtime_ns) {
+                listing_changed = 1;
+                break;
+            }
+        }
+        for (uint32_t i = 0; !status->reason && i < h->num_packages; i++) {
+            package_record* p = &packages[i];
+            if (!build_file_path(file, sizeof(file), abs_root, names + p->name) || stat(file, &st) != 0) {
+                status->reason = "a BUILD file was removed";
+            } else if ((uint64_t)st.st_size != p->size) {
+                status->reason = "a BUILD file changed";
+            } else if (stat_mtime(&st) != p->mtime_ns) {
+                uint8_t md5[16];
+                status->rehashed++;
+                if (!md5_file(file, md5) || memcmp(md5, p->md5, 16) != 0) status->reason = "a BUILD file changed";
+                p->mtime_ns = stat_mtime(&st);
+                status->restamped = 1;
+            }
+        }
+    }
+
+    // Same BUILD files in the same places?
+    build_tree tree = {0};
+    int have_tree = 0;
+    if (!status->reason && listing_changed) {
+        if (!graph_scan_tree(abs_root, &tree)) {
+            free(dirs);
+            free(packages);
+            graph_free(g);
+            return NULL;
+        }
+        have_tree = 1;
+        int same = tree.num_packages == h->num_packages;
+        for (size_t i = 0; same && i < tree.num_packages; i++) {
+            same = strcmp(tree.packages[i], names + packages[i].name) == 0;
+        }
+        if (!same) status->reason = "BUILD files were added or removed";
+        status->restamped = 1;
+    }
+
+    if (status->reason) {
+        free(dirs);
+        free(packages);
+        graph_free(g);
+        if (!have_tree && !graph_scan_tree(abs_root, &tree)) return NULL;
+        status->compiled = 1;
+        status->restamped = 0;
+        g = compile_graph_file(abs_root, path, &tree);
+        graph_tree_free(&tree);
+        return g;
+    }
+
+    // Touched but unchanged: keep the graph, record the new stamps
+    if (status->restamped) {
+        build_tree current = tree;
+        char** pkg_names = NULL;
+        if (have_tree) {
+            free(dirs);
+            dirs = xcalloc(tree.num_dirs ? tree.num_dirs : 1, sizeof(dir_record));
+        } else {
+            // Unchanged listing: reuse the recorded names
+            current.num_dirs = h->num_dirs;
+            current.dirs = xmalloc((h->num_dirs ? h->num_dirs : 1) * sizeof(char*));
+            for (uint32_t i = 0; i < h->num_dirs; i++) current.dirs[i] = (char*)names + dirs[i].name;
+            pkg_names = xmalloc(h->num_packages * sizeof(char*));
+            for (uint32_t i = 0; i < h->num_packages; i++) pkg_names[i] = (char*)names + packages[i].name;
+            current.packages = pkg_names;
+            current.num_packages = h->num_packages;
+        }
+        for (size_t i = 0; i < current.num_dirs; i++) {
+            dirs[i].mtime_ns = dir_path(file, sizeof(file), abs_root, current.dirs[i]) && stat(file, &st) == 0
+                                   ? stat_mtime(&st)
+                                   : 0;
+        }
+        if (!write_graph_file(path, abs_root, g, &current, dirs, packages)) {
+            fprintf(stderr, "Warning: Cannot update the precompiled graph %s\n", path);
+        }
+        if (!have_tree) {
+            free(current.dirs);
+            free(pkg_names);
+        }
+    }
+
+    if (have_tree) graph_tree_free(&tree);
+    free(dirs);
+    free(packages);
+    return g;
+}
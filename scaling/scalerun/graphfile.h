@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_GRAPHFILE_H
+#define SCALERUN_GRAPHFILE_H
+
+#include "graph.h"
+#include <stdint.h>
+
+// Precompiled graph file: the build_graph arrays (string table, CSR edges
+// and sources, label lookup) laid out for mmap, plus a manifest of the
+// BUILD tree they were compiled from: the mtime of every directory walked
+// and the mtime, size and md5 of every BUILD file.
+
+typedef struct {
+    int compiled;           // BUILD files were parsed and the file rewritten
+    int restamped;          // only the manifest changed: touched files, same contents
+    uint32_t rehashed;      // BUILD files whose mtime changed and were re-hashed
+    const char* reason;     // why the file was compiled
+} graph_file_status;
+
+// Map 'path', recompiling it from the BUILD tree under 'root' first when it
+// is missing, from another version, or a BUILD file was added, removed or
+// changed content. 'status' may be NULL.
+build_graph* graph_file_open(const char* root, const char* path, graph_file_status* status);
+
+// Map 'path' as is, without checking it against the tree
+build_graph* graph_file_map(const char* path);
+
+#endif // SCALERUN_GRAPHFILE_H
@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_MD5_H
+#define SCALERUN_MD5_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// MD5 (RFC 1321), the digest run_build.sh computes with md5sum
+typedef struct {
+    uint32_t state[4];
+    uint64_t length;
+    unsigned char buffer[64];
+} md5_ctx;
+
+void md5_init(md5_ctx* ctx);
+void md5_update(md5_ctx* ctx, const void* data, size_t len);
+void md5_final(md5_ctx* ctx, uint8_t digest[16]);
+
+// Helpers
+void md5_hex(const uint8_t digest[16], char hex[33]);
+int md5_fd(int fd, uint8_t digest[16]);
+int md5_file(const char* path, uint8_t digest[16]);
+
+#endif // SCALERUN_MD5_H
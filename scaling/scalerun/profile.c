@@ -0,0 +1,349 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "profile.h"
+#include "common.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TIMINGS_FILE "timings.tsv"
+
+void profile_recorder_init(profile_recorder* rec, const build_graph* graph, sched_task_fn task, void* ctx) {
+    rec->task = task;
+    rec->ctx = ctx;
+    rec->base = now_seconds();
+    rec->start = xcalloc(graph->num_targets, sizeof(double));
+    rec->end = xcalloc(graph->num_targets, sizeof(double));
+    rec->worker = xcalloc(graph->num_targets, sizeof(int));
+    rec->ran = xcalloc(graph->num_targets, sizeof(uint8_t));
+}
+
+void profile_recorder_free(profile_recorder* rec) {
+    if (!rec) return;
+    free(rec->start);
+    free(rec->end);
+    free(rec->worker);
+    free(rec->ran);
+    memset(rec, 0, sizeof(*rec));
+}
+
+int profile_task(void* context, uint32_t target, int worker) {
+    // Each target runs once, on one worker: no synchronization needed
+    profile_recorder* rec = context;
+    rec->start[target] = now_seconds();
+    int ok = rec->task(rec->ctx, target, worker);
+    rec->end[target] = now_seconds();
+    rec->worker[target] = worker;
+    rec->ran[target] = 1;
+    return ok;
+}
+
+int profile_load_costs(const build_graph* graph, const char* state_dir, double* cost, uint8_t* known) {
+    memset(cost, 0, graph->num_targets * sizeof(double));
+    memset(known, 0, graph->num_targets);
+
+    char path[PATH_MAX];
+    char* data = join_path(path, sizeof(path), state_dir, TIMINGS_FILE) ? read_file(path, NULL) : NULL;
+    if (!data) return 0;
+
+    int count = 0;
+    for (char* line = data; line && *line;) {
+        char* end = strchr(line, '\n');
+        if (end) *end = '\0';
+        char* tab = strchr(line, '\t');
+        if (tab) {
+            *tab = '\0';
+            int t = graph_find(graph, line);
+            if (t >= 0) {
+                cost[t] = strtod(tab + 1, NULL);
+                known[t] = 1;
+                count++;
+            }
+        }
+        line = end ? end + 1 : NULL;
+    }
+    free(data);
+    return count;
+}
+
+int profile_save_costs(const build_graph* graph, const char* state_dir, const profile_recorder* rec,
+                       const uint8_t* measured) {
+    uint32_t n = graph->num_targets;
+    double* cost = xmalloc(n * sizeof(double));
+    uint8_t* known = xmalloc(n);
+    profile_load_costs(graph, state_dir, cost, known);
+    for (uint32_t t = 0; t < n; t++) {
+        if (!rec->ran[t] || !measured[t]) continue;
+        cost[t] = rec->end[t] - rec->start[t];
+        known[t] = 1;
+    }
+
+    char path[PATH_MAX], tmp[PATH_MAX];
+    int ok = join_path(path, sizeof(path), state_dir, TIMINGS_FILE) &&
+             join_path(tmp, sizeof(tmp), state_dir, TIMINGS_FILE ".tmp");
+    FILE* file = ok ? fopen(tmp, "w") : NULL;
+    if (file) {
+        fprintf(file, "target\tseconds\n");
+        for (uint32_t t = 0; t < n; t++) {
+            if (known[t]) fprintf(file, "//%s\t%.6f\n", graph_str(graph, graph->label[t]), cost[t]);
+        }
+        ok = !ferror(file);
+        ok = fclose(file) == 0 && ok;
+        if (ok) ok = rename(tmp, path) == 0;
+        if (!ok) unlink(tmp);
+    } else {
+        ok = 0;
+    }
+
+    free(cost);
+    free(known);
+    return ok;
+}
+
+static void write_json_string(FILE* file, const char* str) {
+    fputc('"', file);
+    for (; *str; str++) {
+        unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\') fprintf(file, "\\%c", c);
+        else if (c < 0x20) fprintf(file, "\\u%04x", c);
+        else fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+int profile_write_trace(const build_graph* graph, const profile_recorder* rec, const char* path) {
+    static const char* kind_names[] = {"shell_sources", "adhoc_tool", "run_shell_command", "other"};
+    FILE* file = fopen(path, "w");
+    if (!file) return 0;
+
+    int num_workers = 0;
+    for (uint32_t t = 0; t < graph->num_targets; t++) {
+        if (rec->ran[t] && rec->worker[t] + 1 > num_workers) num_workers = rec->worker[t] + 1;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"scalerun\"}}");
+    for (int w = 0; w < num_workers; w++) {
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"worker %d\"}}",
+                w, w);
+    }
+    for (uint32_t t = 0; t < graph->num_targets; t++) {
+        if (!rec->ran[t]) continue;
+        fprintf(file, ",\n{\"name\":");
+        write_json_string(file, graph_str(graph, graph->label[t]));
+        fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                kind_names[graph->kind[t] & 3], rec->worker[t], (rec->start[t] - rec->base) * 1e6,
+                (rec->end[t] - rec->start[t]) * 1e6);
+    }
+    fprintf(file, "\n]}\n");
+
+    int ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// Binary min-heap of (key, target)
+typedef struct {
+    double key;
+    uint32_t target;
+} heap_entry;
+
+typedef struct {
+    heap_entry* data;
+    size_t len;
+} heap;
+
+static void heap_push(heap* h, double key, uint32_t target) {
+    size_t i = h->len++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (h->data[parent].key <= key) break;
+        h->data[i] = h->data[parent];
+        i = parent;
+    }
+    h->data[i].key = key;
+    h->data[i].target = target;
+}
+
+static heap_entry heap_pop(heap* h) {
+    heap_entry top = h->data[0];
+    heap_entry last = h->data[--h->len];
+    size_t i = 0;
+    for (;;) {
+        size_t child = i * 2 + 1;
+        if (child >= h->len) break;
+        if (child + 1 < h->len && h->data[child + 1].key < h->data[child].key) child++;
+        if (last.key <= h->data[child].key) break;
+        h->data[i] = h->data[child];
+        i = child;
+    }
+    if (h->len) h->data[i] = last;
+    return top;
+}
+
+// Greedy list scheduling on 'cores', longest remaining path first
+static double simulate(const build_graph* g, const uint8_t* wanted, const double* cost, const double* bottom,
+                       uint32_t num_wanted, int cores) {
+    uint32_t n = g->num_targets;
+    uint32_t* remaining = xcalloc(n, sizeof(uint32_t));
+    heap ready = {xmalloc((num_wanted + 1) * sizeof(heap_entry)), 0};
+    heap running = {xmalloc((num_wanted + 1) * sizeof(heap_entry)), 0};
+
+    for (uint32_t t = 0; t < n; t++) {
+        if (!wanted[t]) continue;
+        for (uint32_t i = g->dep_index[t]; i < g->dep_index[t + 1]; i++) remaining[t] += wanted[g->deps[i]];
+        if (!remaining[t]) heap_push(&ready, -bottom[t], t);
+    }
+
+    double now = 0;
+    int idle = cores;
+    while (ready.len || running.len) {
+        while (idle > 0 && ready.len) {
+            uint32_t t = heap_pop(&ready).target;
+            heap_push(&running, now + cost[t], t);
+            idle--;
+        }
+        heap_entry done = heap_pop(&running);
+        now = done.key;
+        idle++;
+        for (uint32_t i = g->rdep_index[done.target]; i < g->rdep_index[done.target + 1]; i++) {
+            uint32_t d = g->rdeps[i];
+            if (wanted[d] && --remaining[d] == 0) heap_push(&ready, -bottom[d], d);
+        }
+    }
+
+    free(remaining);
+    free(ready.data);
+    free(running.data);
+    return now;
+}
+
+void profile_report(const build_graph* g, const uint8_t* wanted, const double* measured_cost, const uint8_t* known) {
+    uint32_t n = g->num_targets;
+
+    // Fill in unknown costs with the mean of the same kind
+    double sum[4] = {0};
+    uint32_t count[4] = {0}, num_known = 0;
+    for (uint32_t t = 0; t < n; t++) {
+        if (!wanted[t] || !known[t]) continue;
+        sum[g->kind[t]] += measured_cost[t];
+        count[g->kind[t]]++;
+        num_known++;
+    }
+    double* cost = xmalloc(n * sizeof(double));
+    for (uint32_t t = 0; t < n; t++) {
+        uint8_t k = g->kind[t];
+        if (!num_known) cost[t] = k == TARGET_TOOL || k == TARGET_COMMAND ? 1.0 : 0.0;
+        else if (known[t]) cost[t] = measured_cost[t];
+        else cost[t] = count[k] ? sum[k] / count[k] : 0.0;
+    }
+    const char* unit = num_known ? "s" : "units";
+
+    // Topological order of the wanted targets
+    uint32_t* order = xmalloc(n * sizeof(uint32_t));
+    uint32_t* remaining = xcalloc(n, sizeof(uint32_t));
+    uint32_t num_wanted = 0, head = 0;
+    for (uint32_t t = 0; t < n; t++) {
+        if (!wanted[t]) continue;
+        for (uint32_t i = g->dep_index[t]; i < g->dep_index[t + 1]; i++) remaining[t] += wanted[g->deps[i]];
+        if (!remaining[t]) order[num_wanted++] = t;
+    }
+    while (head < num_wanted) {
+        uint32_t t = order[head++];
+        for (uint32_t i = g->rdep_index[t]; i < g->rdep_index[t + 1]; i++) {
+            uint32_t d = g->rdeps[i];
+            if (wanted[d] && --remaining[d] == 0) order[num_wanted++] = d;
+        }
+    }
+    free(remaining);
+    if (!num_wanted) {
+        free(order);
+        free(cost);
+        return;
+    }
+
+    // Depth and earliest finish with unlimited cores, then the longest
+    // remaining path from each target for the scheduling priority
+    uint32_t* depth = xcalloc(n, sizeof(uint32_t));
+    uint32_t* pred = xmalloc(n * sizeof(uint32_t));
+    double* finish = xcalloc(n, sizeof(double));
+    double* bottom = xcalloc(n, sizeof(double));
+    double work = 0;
+    uint32_t max_depth = 0, last = order[0];
+    for (uint32_t i = 0; i < num_wanted; i++) {
+        uint32_t t = order[i];
+        double ready = 0;
+        pred[t] = UINT32_MAX;
+        for (uint32_t j = g->dep_index[t]; j < g->dep_index[t + 1]; j++) {
+            uint32_t d = g->deps[j];
+            if (!wanted[d]) continue;
+            if (depth[d] + 1 > depth[t]) depth[t] = depth[d] + 1;
+            if (pred[t] == UINT32_MAX || finish[d] > ready) {
+                ready = finish[d];
+                pred[t] = d;
+            }
+        }
+        finish[t] = ready + cost[t];
+        work += cost[t];
+        if (depth[t] > max_depth) max_depth = depth[t];
+        if (finish[t] > finish[last]) last = t;
+    }
+    for (uint32_t i = num_wanted; i-- > 0;) {
+        uint32_t t = order[i];
+        double longest = 0;
+        for (uint32_t j = g->rdep_index[t]; j < g->rdep_index[t + 1]; j++) {
+            uint32_t d = g->rdeps[j];
+            if (wanted[d] && bottom[d] > longest) longest = bottom[d];
+        }
+        bottom[t] = cost[t] + longest;
+    }
+    double critical = finish[last];
+
+    printf("Profile of %u targets (%s)\n", num_wanted,
+           num_known ? "costs from timings.tsv, unmeasured targets at their kind's mean"
+                     : "no timings recorded: one unit per tool");
+    printf("  total work %.3f %s, critical path %.3f %s, average parallelism %.1f\n", work, unit, critical, unit,
+           critical > 0 ? work / critical : 0.0);
+
+    // The chain itself, from the first target to the last
+    uint32_t chain_len = 0;
+    for (uint32_t t = last; t != UINT32_MAX; t = pred[t]) order[chain_len++] = t;
+    printf("\nCritical path (%u targets):\n", chain_len);
+    for (uint32_t i = chain_len; i-- > 0;) {
+        uint32_t t = order[i];
+        printf("  %10.3f %s  //%s\n", cost[t], unit, graph_str(g, g->label[t]));
+    }
+
+    uint32_t* width = xcalloc(max_depth + 1, sizeof(uint32_t));
+    for (uint32_t t = 0; t < n; t++) {
+        if (wanted[t]) width[depth[t]]++;
+    }
+    uint32_t widest = 0;
+    for (uint32_t d = 0; d <= max_depth; d++) {
+        if (width[d] > width[widest]) widest = d;
+    }
+    printf("\nWidth by depth (%u levels, widest %u at depth %u):\n", max_depth + 1, width[widest], widest);
+    for (uint32_t d = 0; d <= max_depth; d++) printf("  depth %4u: %u\n", d, width[d]);
+    free(width);
+
+    printf("\nSpeedup over one core:\n");
+    printf("  %6s  %8s  %9s  %12s\n", "cores", "bound", "simulated", "makespan");
+    double serial = work > 0 ? work : 1;
+    for (int cores = 1; cores <= 256; cores *= 2) {
+        double floor = work / cores > critical ? work / cores : critical;
+        double makespan = simulate(g, wanted, cost, bottom, num_wanted, cores);
+        printf("  %6d  %8.2f  %9.2f  %10.3f %s\n", cores, floor > 0 ? serial / floor : 1.0,
+               makespan > 0 ? serial / makespan : 1.0, makespan, unit);
+    }
+
+    free(order);
+    free(cost);
+    free(depth);
+    free(pred);
+    free(finish);
+    free(bottom);
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_PROFILE_H
+#define SCALERUN_PROFILE_H
+
+#include "graph.h"
+#include "scheduler.h"
+#include <stdint.h>
+
+// Times every target of a build: wraps the real task and records when and
+// on which worker each target ran
+typedef struct {
+    sched_task_fn task;
+    void* ctx;
+    double base;            // start of the build, trace timestamps are relative to it
+    double* start;
+    double* end;
+    int* worker;
+    uint8_t* ran;
+} profile_recorder;
+
+void profile_recorder_init(profile_recorder* rec, const build_graph* graph, sched_task_fn task, void* ctx);
+void profile_recorder_free(profile_recorder* rec);
+
+// sched_task_fn with a profile_recorder as its context
+int profile_task(void* rec, uint32_t target, int worker);
+
+// Per-target costs in seconds, kept in <state>/timings.tsv across runs.
+// Saving merges the targets marked in 'measured' into the existing file.
+int profile_load_costs(const build_graph* graph, const char* state_dir, double* cost, uint8_t* known);
+int profile_save_costs(const build_graph* graph, const char* state_dir, const profile_recorder* rec,
+                       const uint8_t* measured);
+
+// Chrome trace (chrome://tracing, Perfetto) of the recorded build, one track per worker
+int profile_write_trace(const build_graph* graph, const profile_recorder* rec, const char* path);
+
+// Critical path, width per depth and speedup at N cores over the wanted
+// targets. Targets without a known cost get the mean of their kind; with no
+// timings at all every tool costs one unit.
+void profile_report(const build_graph* graph, const uint8_t* wanted, const double* cost, const uint8_t* known);
+
+#endif // SCALERUN_PROFILE_H
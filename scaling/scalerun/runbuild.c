@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "runbuild.h"
+#include "common.h"
+#include "md5.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int stream_input(md5_ctx* md5, const runbuild_input* input, runbuild_bytes* bytes) {
+    if (!input->disk_path) {
+        md5_update(md5, input->data, input->len);
+        bytes->streamed += input->len;
+        return 1;
+    }
+
+    int fd = open(input->disk_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    unsigned char buffer[65536];
+    ssize_t n;
+    int ok = 1;
+    while ((n = read(fd, buffer, sizeof(buffer))) != 0) {
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = 0;
+            break;
+        }
+        md5_update(md5, buffer, (size_t)n);
+        bytes->streamed += (uint64_t)n;
+        bytes->read += (uint64_t)n;
+    }
+    close(fd);
+    return ok;
+}
+
+int runbuild_hash(const runbuild_input* top, size_t num_top, const runbuild_input* all, size_t num_all,
+                  uint8_t result[16], runbuild_bytes* bytes) {
+    runbuild_bytes counted = {0, 0};
+    md5_ctx md5;
+    md5_init(&md5);
+
+    for (size_t i = 0; i < num_top; i++) {
+        if (!stream_input(&md5, &top[i], &counted)) return 0;
+    }
+    for (size_t i = 0; i < num_all; i++) {
+        if (!stream_input(&md5, &all[i], &counted)) return 0;
+    }
+
+    md5_final(&md5, result);
+    if (bytes) *bytes = counted;
+    return 1;
+}
+
+// Per path component, so "a/x" sorts before "a-b" as in a sorted walk;
+// strcmp would put "a-b" first because '-' is below '/'
+static int compare_inputs(const void* a, const void* b) {
+    const unsigned char* x = (const unsigned char*)((const runbuild_input*)a)->name;
+    const unsigned char* y = (const unsigned char*)((const runbuild_input*)b)->name;
+    while (*x && *x == *y) {
+        x++;
+        y++;
+    }
+    if (*x == *y) return 0;
+    if (!*x || !*y) return *x ? 1 : -1;
+    if (*x == '/' || *y == '/') return *x == '/' ? -1 : 1;
+    return *x < *y ? -1 : 1;
+}
+
+void runbuild_sort(runbuild_input* inputs, size_t count) {
+    if (inputs && count > 1) qsort(inputs, count, sizeof(runbuild_input), compare_inputs);
+}
+
+static void scan_add(runbuild_input** list, size_t* count, size_t* cap, const char* chroot, const char* name) {
+    if (*count == *cap) {
+        *cap = *cap ? *cap * 2 : 64;
+        *list = xrealloc(*list, *cap * sizeof(runbuild_input));
+    }
+    size_t len = strlen(chroot) + strlen(name) + 2;
+    char* path = xmalloc(len);
+    snprintf(path, len, "%s/%s", chroot, name);
+
+    runbuild_input* input = &(*list)[(*count)++];
+    input->name = xstrdup(name);
+    input->disk_path = path;
+    input->data = NULL;
+    input->len = 0;
+}
+
+// Pre-order walk in readdir order, as find does it
+static int scan_dir(const char* chroot, const char* rel, const char* exclude, runbuild_input** list, size_t* count,
+                    size_t* cap) {
+    char path[PATH_MAX];
+    if (*rel) {
+        if (!join_path(path, sizeof(path), chroot, rel)) return 0;
+    } else {
+        snprintf(path, sizeof(path), "%s", chroot);
+    }
+
+    DIR* dir = opendir(path);
+    if (!dir) return 0;
+
+    int ok = 1;
+    struct dirent* entry;
+    while (ok && (entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+        char child[PATH_MAX];
+        if (*rel) {
+            if (!join_path(child, sizeof(child), rel, entry->d_name)) ok = 0;
+        } else {
+            snprintf(child, sizeof(child), "%s", entry->d_name);
+        }
+
+        struct stat st;
+        char full[PATH_MAX];
+        if (!ok || !join_path(full, sizeof(full), chroot, child) || lstat(full, &st) != 0) {
+            ok = 0;
+        } else if (S_ISDIR(st.st_mode)) {
+            ok = scan_dir(chroot, child, exclude, list, count, cap);
+        } else if (S_ISREG(st.st_mode) && (!exclude || strcmp(child, exclude) != 0)) {
+            scan_add(list, count, cap, chroot, child);
+        }
+    }
+    closedir(dir);
+    return ok;
+}
+
+int runbuild_scan_chroot(const char* chroot, const char* exclude, runbuild_scan* scan) {
+    memset(scan, 0, sizeof(*scan));
+    size_t cap_all = 0, cap_top = 0;
+
+    if (!scan_dir(chroot, "", exclude, &scan->all, &scan->num_all, &cap_all)) {
+        runbuild_scan_free(scan);
+        return 0;
+    }
+
+    // '*' matches the root entries; cat skips the directories among them
+    for (size_t i = 0; i < scan->num_all; i++) {
+        if (!strchr(scan->all[i].name, '/')) scan_add(&scan->top, &scan->num_top, &cap_top, chroot, scan->all[i].name);
+    }
+    runbuild_sort(scan->top, scan->num_top);
+    return 1;
+}
+
+static void free_inputs(runbuild_input* inputs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free((char*)inputs[i].name);
+        free((char*)inputs[i].disk_path);
+    }
+    free(inputs);
+}
+
+void runbuild_scan_free(runbuild_scan* scan) {
+    if (!scan) return;
+    free_inputs(scan->top, scan->num_top);
+    free_inputs(scan->all, scan->num_all);
+    memset(scan, 0, sizeof(*scan));
+}
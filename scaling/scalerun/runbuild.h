@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_RUNBUILD_H
+#define SCALERUN_RUNBUILD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// In-process equivalent of geomorphy/run_build.sh, which runs
+//   cat * $(find "$chroot" -type f) | md5sum
+// inside the chroot. The md5 covers the regular files at the chroot root
+// in glob order, followed by every file in the chroot in find order.
+typedef struct {
+    const char* name;       // path relative to the chroot
+    const char* disk_path;  // read the contents from here, or
+    const char* data;       // use these bytes when disk_path is NULL
+    size_t len;
+} runbuild_input;
+
+typedef struct {
+    uint64_t streamed;      // bytes fed to md5, what md5sum would see
+    uint64_t read;          // bytes read from disk to produce them
+} runbuild_bytes;
+
+int runbuild_hash(const runbuild_input* top, size_t num_top, const runbuild_input* all, size_t num_all,
+                  uint8_t result[16], runbuild_bytes* bytes);
+
+// Glob order under LC_ALL=C for root names; for paths, the order find lists
+// them in when every directory reads back sorted
+void runbuild_sort(runbuild_input* inputs, size_t count);
+
+// List a materialized chroot the way '*' and find see it, skipping 'exclude'
+typedef struct {
+    runbuild_input* top;
+    size_t num_top;
+    runbuild_input* all;
+    size_t num_all;
+} runbuild_scan;
+
+int runbuild_scan_chroot(const char* chroot, const char* exclude, runbuild_scan* scan);
+void runbuild_scan_free(runbuild_scan* scan);
+
+#endif // SCALERUN_RUNBUILD_H
@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "action.h"
+#include "cache.h"
+#include "common.h"
+#include "graph.h"
+#include "graphfile.h"
+#include "profile.h"
+#include "scheduler.h"
+#include "state.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void usage(void) {
+    printf("Usage: scalerun [options] [target...]\n");
+    printf("Build targets of a scaling/ BUILD tree (default target: //:go)\n\n");
+    printf("Options:\n");
+    printf("  -C DIR   Root of the BUILD tree (default: .)\n");
+    printf("  -s DIR   State directory for outputs and chroots (default: ROOT/.scalerun)\n");
+    printf("  -j N     Number of worker threads (default: online CPUs)\n");
+    printf("  -i       Incremental: only run targets downstream of changed inputs\n");
+    printf("  -k       Keep going after a failure\n");
+    printf("  -m MODE  How adhoc_tool targets run: script (default), inproc or verify\n");
+    printf("  -n       Load the graph and print statistics without building\n");
+    printf("  -p       Profile: critical path, width and speedup from recorded timings, without building\n");
+    printf("  -t FILE  Write a Chrome trace of this build to FILE\n");
+    printf("  -P       Parse the BUILD files instead of using the precompiled graph\n");
+    printf("  -x       Do not use the action cache\n");
+    printf("  -h       Show this help message\n");
+}
+
+typedef struct {
+    const char* root;
+    const char* state_dir;
+    sched_options options;
+    int use_cache;
+    int incremental;
+    action_mode mode;
+    const char* trace_path;
+} build_settings;
+
+static void print_graph_stats(const build_graph* g, double seconds) {
+    uint32_t counts[4] = {0};
+    for (uint32_t t = 0; t < g->num_targets; t++) counts[g->kind[t]]++;
+
+    printf("Loaded %u targets from %zu BUILD files in %.3f s\n", g->num_targets, g->num_build_files, seconds);
+    printf("  %u adhoc_tool, %u shell_sources, %u run_shell_command, %u other\n", counts[TARGET_TOOL],
+           counts[TARGET_SOURCES], counts[TARGET_COMMAND], counts[TARGET_OTHER]);
+    printf("  %zu dependency edges (%zu declared, %zu duplicates removed)\n", graph_num_edges(g), g->raw_edges,
+           g->raw_edges - graph_num_edges(g) - g->dropped_edges);
+    if (g->dropped_edges) printf("  %zu circular edges dropped\n", g->dropped_edges);
+}
+
+// Bytes hashed per tool, summarized here and listed in <state>/bytes.tsv
+static void report_bytes(const build_graph* g, const action_context* ctx, const uint8_t* run, const char* state_dir) {
+    char path[PATH_MAX];
+    FILE* file = join_path(path, sizeof(path), state_dir, "bytes.tsv") ? fopen(path, "w") : NULL;
+    if (file) fprintf(file, "target\tstreamed\tread\n");
+
+    uint32_t count = 0;
+    uint64_t streamed = 0, read = 0, max_read = 0;
+    for (uint32_t t = 0; t < g->num_targets; t++) {
+        if (!run[t] || !ctx->done[t] || g->kind[t] != TARGET_TOOL) continue;
+        const runbuild_bytes* b = &ctx->bytes[t];
+        if (!b->streamed) continue;  // cache hit
+        count++;
+        streamed += b->streamed;
+        read += b->read;
+        if (b->read > max_read) max_read = b->read;
+        if (file) fprintf(file, "//%s\t%llu\t%llu\n", graph_str(g, g->label[t]), (unsigned long long)b->streamed,
+                          (unsigned long long)b->read);
+    }
+    if (file && fclose(file) != 0) file = NULL;
+    if (!count) return;
+
+    printf("  hashed %u tools: %.1f MB streamed, %.1f MB read from disk (%.1f KB per tool, max %.1f KB)\n", count,
+           streamed / 1e6, read / 1e6, read / 1e3 / count, max_read / 1e3);
+    if (file) printf("  per-target byte counts in %s\n", path);
+}
+
+static int run_build(const build_graph* graph, const uint8_t* wanted, const build_settings* settings) {
+    action_cache cache = {0};
+    action_context ctx = {0};
+    build_state* state = state_load(graph, settings->state_dir);
+    // verify runs the script, so its digests are the script's
+    state->digest_mode = settings->mode == ACTION_INPROC ? ACTION_INPROC : ACTION_SCRIPT;
+    int ok = (!settings->use_cache || cache_init(&cache, settings->state_dir)) &&
+             action_init(&ctx, graph, settings->root, settings->state_dir, settings->use_cache ? &cache : NULL,
+                         state, settings->mode);
+
+    // Incremental: run only the dirty cone, reuse digests for the rest. A
+    // verify run has to run the script everywhere, so it skips nothing.
+    uint8_t* run = xmalloc(graph->num_targets);
+    memcpy(run, wanted, graph->num_targets);
+    if (ok && settings->incremental && settings->mode != ACTION_VERIFY) {
+        state_plan plan;
+        state_dirty_cone(state, graph, ctx.root, ctx.out_dir, wanted, run, &plan);
+        for (uint32_t t = 0; t < graph->num_targets; t++) {
+            if (wanted[t] && !run[t]) memcpy(ctx.digest[t], state->digest[t], 16);
+        }
+        printf("Incremental: %u source files changed (%u touched), %u targets to run, %u of %u skipped\n",
+               plan.content_changed, plan.stat_changed, plan.dirty, plan.skipped, plan.dirty + plan.skipped);
+        fflush(stdout);
+    }
+
+    if (ok) {
+        sched_stats stats;
+        profile_recorder rec;
+        profile_recorder_init(&rec, graph, action_run, &ctx);
+        ok = sched_run(graph, run, &settings->options, profile_task, &rec, &stats);
+        printf("Ran %u targets in %.3f s on %d workers (%llu steals)\n", stats.executed, stats.seconds,
+               settings->options.num_workers, (unsigned long long)stats.steals);
+        if (stats.failed || stats.skipped) {
+            printf("  %u failed, %u skipped because a dependency failed\n", stats.failed, stats.skipped);
+        }
+        if (settings->use_cache) {
+            printf("  action cache: %u hits, %u misses\n", atomic_load(&ctx.cache_hits),
+                   atomic_load(&ctx.cache_misses));
+        }
+        if (settings->mode != ACTION_SCRIPT) report_bytes(graph, &ctx, run, settings->state_dir);
+
+        // Cache hits say nothing about what the action costs
+        uint8_t* measured = xmalloc(graph->num_targets);
+        for (uint32_t t = 0; t < graph->num_targets; t++) measured[t] = ctx.done[t] && !ctx.cache_hit[t];
+        if (!profile_save_costs(graph, settings->state_dir, &rec, measured)) {
+            fprintf(stderr, "Warning: Cannot save target timings in %s\n", settings->state_dir);
+        }
+        free(measured);
+        if (settings->trace_path) {
+            if (profile_write_trace(graph, &rec, settings->trace_path)) {
+                printf("  trace written to %s\n", settings->trace_path);
+            } else {
+                fprintf(stderr, "Warning: Cannot write trace %s\n", settings->trace_path);
+            }
+        }
+        profile_recorder_free(&rec);
+
+        for (uint32_t t = 0; t < graph->num_targets; t++) {
+            if (!run[t]) continue;
+            if (ctx.done[t]) state_record(state, graph, t, ctx.digest[t]);
+            else state->target_known[t] = 0;
+        }
+        if (!state_save(state, graph, settings->state_dir)) {
+            fprintf(stderr, "Warning: Cannot save build state in %s\n", settings->state_dir);
+        }
+    }
+
+    free(run);
+    action_cleanup(&ctx);
+    cache_cleanup(&cache);
+    state_free(state);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    build_settings settings = {".", NULL, {sched_default_workers(), 0}, 1, 0, ACTION_SCRIPT, NULL};
+    int dry_run = 0;
+    int profile = 0;
+    int precompiled = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "C:s:j:ikm:npt:Pxh")) != -1) {
+        switch (opt) {
+        case 'C': settings.root = optarg; break;
+        case 's': settings.state_dir = optarg; break;
+        case 'j': settings.options.num_workers = atoi(optarg); break;
+        case 'i': settings.incremental = 1; break;
+        case 'k': settings.options.keep_going = 1; break;
+        case 'm':
+            if (strcmp(optarg, "script") == 0) settings.mode = ACTION_SCRIPT;
+            else if (strcmp(optarg, "inproc") == 0) settings.mode = ACTION_INPROC;
+            else if (strcmp(optarg, "verify") == 0) settings.mode = ACTION_VERIFY;
+            else {
+                fprintf(stderr, "Error: Unknown mode %s (script, inproc or verify)\n", optarg);
+                return 1;
+            }
+            break;
+        case 'n': dry_run = 1; break;
+        case 'p': profile = 1; break;
+        case 't': settings.trace_path = optarg; break;
+        case 'P': precompiled = 0; break;
+        case 'x': settings.use_cache = 0; break;
+        case 'h': usage(); return 0;
+        default: usage(); return 1;
+        }
+    }
+    if (settings.options.num_workers < 1) {
+        fprintf(stderr, "Error: -j needs a positive number\n");
+        return 1;
+    }
+
+    char default_state[4096];
+    if (!settings.state_dir) {
+        snprintf(default_state, sizeof(default_state), "%s/.scalerun", settings.root);
+        settings.state_dir = default_state;
+    }
+
+    // The precompiled graph lives in <state>/graph.bin
+    double start = now_seconds();
+    build_graph* graph = NULL;
+    graph_file_status status = {0};
+    char graph_path[4096];
+    if (precompiled && make_dirs(settings.state_dir) &&
+        join_path(graph_path, sizeof(graph_path), settings.state_dir, "graph.bin")) {
+        graph = graph_file_open(settings.root, graph_path, &status);
+    } else {
+        graph = graph_load(settings.root);
+    }
+    if (!graph) return 1;
+    print_graph_stats(graph, now_seconds() - start);
+    if (status.compiled) {
+        printf("  compiled %s (%s)\n", graph_path, status.reason);
+    } else if (graph->mapping) {
+        printf("  mapped %s%s\n", graph_path, status.restamped ? ", stamps refreshed" : "");
+    }
+
+    size_t num_roots = optind < argc ? (size_t)(argc - optind) : 1;
+    uint32_t* roots = xmalloc(num_roots * sizeof(uint32_t));
+    for (size_t i = 0; i < num_roots; i++) {
+        const char* label = optind < argc ? argv[optind + (int)i] : ":go";
+        int target = graph_find(graph, label);
+        if (target < 0) {
+            fprintf(stderr, "Error: Unknown target %s\n", label);
+            free(roots);
+            graph_free(graph);
+            return 1;
+        }
+        roots[i] = (uint32_t)target;
+    }
+
+    uint8_t* wanted = xcalloc(graph->num_targets, sizeof(uint8_t));
+    sched_closure(graph, roots, num_roots, wanted);
+    free(roots);
+
+    uint32_t num_wanted = 0;
+    for (uint32_t t = 0; t < graph->num_targets; t++) num_wanted += wanted[t];
+    printf("%u targets in the requested closure\n", num_wanted);
+    fflush(stdout);
+
+    int ok = 1;
+    if (profile) {
+        double* cost = xmalloc(graph->num_targets * sizeof(double));
+        uint8_t* known = xmalloc(graph->num_targets);
+        profile_load_costs(graph, settings.state_dir, cost, known);
+        profile_report(graph, wanted, cost, known);
+        free(cost);
+        free(known);
+    } else if (!dry_run) {
+        ok = run_build(graph, wanted, &settings);
+    }
+
+    free(wanted);
+    graph_free(graph);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "scheduler.h"
+#include "common.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Chase-Lev work-stealing deque. Every target is pushed at most once per
+// run, so a buffer as large as the number of wanted targets never wraps.
+typedef struct {
+    _Atomic long top;
+    _Atomic long bottom;
+    uint32_t* buffer;
+} work_deque;
+
+static void deque_push(work_deque* dq, uint32_t target) {
+    long b = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+    dq->buffer[b] = target;
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+}
+
+static int deque_pop(work_deque* dq, uint32_t* target) {
+    long b = atomic_load_explicit(&dq->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&dq->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long t = atomic_load_explicit(&dq->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+        return 0;
+    }
+
+    *target = dq->buffer[b];
+    if (t == b) {
+        // Last element: race against thieves for it
+        int won = atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1, memory_order_seq_cst,
+                                                          memory_order_relaxed);
+        atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return 1;
+}
+
+static int deque_steal(work_deque* dq, uint32_t* target) {
+    long t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+    if (t >= b) return 0;
+
+    *target = dq->buffer[t];
+    return atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1, memory_order_seq_cst,
+                                                   memory_order_relaxed);
+}
+
+typedef struct scheduler scheduler;
+
+typedef struct {
+    scheduler* sched;
+    int id;
+    work_deque deque;
+    unsigned int rng;
+    pthread_t thread;
+    sched_stats stats;
+} worker;
+
+struct scheduler {
+    const build_graph* graph;
+    const uint8_t* wanted;
+    const sched_options* options;
+    sched_task_fn task;
+    void* ctx;
+
+    _Atomic uint32_t* pending;      // unfinished wanted dependencies
+    _Atomic uint8_t* blocked;       // a dependency failed
+    _Atomic uint32_t remaining;
+    _Atomic int abort;
+
+    worker* workers;
+    int num_workers;
+};
+
+static void complete_target(worker* w, uint32_t target, int failed) {
+    scheduler* s = w->sched;
+    const build_graph* g = s->graph;
+
+    for (uint32_t i = g->rdep_index[target]; i < g->rdep_index[target + 1]; i++) {
+        uint32_t dependent = g->rdeps[i];
+        if (!s->wanted[dependent]) continue;
+        if (failed) atomic_store_explicit(&s->blocked[dependent], 1, memory_order_relaxed);
+        if (atomic_fetch_sub_explicit(&s->pending[dependent], 1, memory_order_acq_rel) == 1) {
+            deque_push(&w->deque, dependent);
+        }
+    }
+    atomic_fetch_sub_explicit(&s->remaining, 1, memory_order_acq_rel);
+}
+
+static int find_work(worker* w, uint32_t* target) {
+    if (deque_pop(&w->deque, target)) return 1;
+
+    scheduler* s = w->sched;
+    for (int attempt = 0; attempt < s->num_workers; attempt++) {
+        w->rng = w->rng * 1103515245u + 12345u;
+        worker* victim = &s->workers[(w->rng >> 16) % (unsigned int)s->num_workers];
+        if (victim == w) continue;
+        if (deque_steal(&victim->deque, target)) {
+            w->stats.steals++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void* worker_main(void* arg) {
+    worker* w = arg;
+    scheduler* s = w->sched;
+    unsigned int idle = 0;
+
+    while (atomic_load_explicit(&s->remaining, memory_order_acquire) > 0 &&
+           !atomic_load_explicit(&s->abort, memory_order_relaxed)) {
+        uint32_t target;
+        if (!find_work(w, &target)) {
+            if (++idle < 64) continue;
+            if (idle < 1024) {
+                sched_yield();
+            } else {
+                struct timespec pause = {0, 100000};
+                nanosleep(&pause, NULL);
+            }
+            continue;
+        }
+        idle = 0;
+
+        if (atomic_load_explicit(&s->blocked[target], memory_order_relaxed)) {
+            w->stats.skipped++;
+            complete_target(w, target, 1);
+            continue;
+        }
+
+        int ok = s->task(s->ctx, target, w->id);
+        w->stats.executed++;
+        if (!ok) {
+            w->stats.failed++;
+            if (!s->options->keep_going) atomic_store(&s->abort, 1);
+        }
+        complete_target(w, target, !ok);
+    }
+    return NULL;
+}
+
+void sched_closure(const build_graph* graph, const uint32_t* roots, size_t num_roots, uint8_t* wanted) {
+    uint32_t* stack = xmalloc((size_t)graph->num_targets * sizeof(uint32_t));
+    size_t depth = 0;
+
+    for (size_t i = 0; i < num_roots; i++) {
+        if (wanted[roots[i]]) continue;
+        wanted[roots[i]] = 1;
+        stack[depth++] = roots[i];
+    }
+    while (depth > 0) {
+        uint32_t t = stack[--depth];
+        for (uint32_t i = graph->dep_index[t]; i < graph->dep_index[t + 1]; i++) {
+            uint32_t dep = graph->deps[i];
+            if (wanted[dep]) continue;
+            wanted[dep] = 1;
+            stack[depth++] = dep;
+        }
+    }
+    free(stack);
+}
+
+int sched_run(const build_graph* graph, const uint8_t* wanted, const sched_options* options,
+              sched_task_fn task, void* ctx, sched_stats* stats) {
+    if (!graph || !wanted || !options || !task) return 0;
+
+    double start = now_seconds();
+    uint32_t n = graph->num_targets;
+    scheduler s = {0};
+    s.graph = graph;
+    s.wanted = wanted;
+    s.options = options;
+    s.task = task;
+    s.ctx = ctx;
+    s.num_workers = options->num_workers > 0 ? options->num_workers : 1;
+    s.pending = xcalloc(n, sizeof(*s.pending));
+    s.blocked = xcalloc(n, sizeof(*s.blocked));
+    s.workers = xcalloc((size_t)s.num_workers, sizeof(worker));
+
+    uint32_t total = 0;
+    for (uint32_t t = 0; t < n; t++) {
+        if (!wanted[t]) continue;
+        total++;
+        uint32_t count = 0;
+        for (uint32_t i = graph->dep_index[t]; i < graph->dep_index[t + 1]; i++) {
+            count += wanted[graph->deps[i]];
+        }
+        atomic_init(&s.pending[t], count);
+    }
+    atomic_init(&s.remaining, total);
+    atomic_init(&s.abort, 0);
+
+    for (int i = 0; i < s.num_workers; i++) {
+        worker* w = &s.workers[i];
+        w->sched = &s;
+        w->id = i;
+        w->rng = 2654435761u * (unsigned int)(i + 1);
+        w->deque.buffer = xmalloc(((size_t)total + 1) * sizeof(uint32_t));
+        atomic_init(&w->deque.top, 0);
+        atomic_init(&w->deque.bottom, 0);
+    }
+
+    // Seed the leaves round-robin so every worker starts with local work
+    int next = 0;
+    for (uint32_t t = 0; t < n; t++) {
+        if (wanted[t] && atomic_load(&s.pending[t]) == 0) {
+            deque_push(&s.workers[next].deque, t);
+            next = (next + 1) % s.num_workers;
+        }
+    }
+
+    for (int i = 1; i < s.num_workers; i++) {
+        if (pthread_create(&s.workers[i].thread, NULL, worker_main, &s.workers[i]) != 0) {
+            fprintf(stderr, "Error: Cannot start worker thread\n");
+            exit(1);
+        }
+    }
+    worker_main(&s.workers[0]);
+    for (int i = 1; i < s.num_workers; i++) pthread_join(s.workers[i].thread, NULL);
+
+    sched_stats total_stats = {0};
+    for (int i = 0; i < s.num_workers; i++) {
+        total_stats.executed += s.workers[i].stats.executed;
+        total_stats.failed += s.workers[i].stats.failed;
+        total_stats.skipped += s.workers[i].stats.skipped;
+        total_stats.steals += s.workers[i].stats.steals;
+        free(s.workers[i].deque.buffer);
+    }
+    total_stats.seconds = now_seconds() - start;
+    int ok = total_stats.failed == 0 && total_stats.skipped == 0 && atomic_load(&s.remaining) == 0;
+
+    free(s.pending);
+    free(s.blocked);
+    free(s.workers);
+    if (stats) *stats = total_stats;
+    return ok;
+}
+
+int sched_default_workers(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_SCHEDULER_H
+#define SCALERUN_SCHEDULER_H
+
+#include "graph.h"
+#include <stdint.h>
+
+// Runs one target; returns 1 on success, 0 on failure
+typedef int (*sched_task_fn)(void* ctx, uint32_t target, int worker);
+
+typedef struct {
+    int num_workers;
+    int keep_going;         // keep building targets not blocked by a failure
+} sched_options;
+
+typedef struct {
+    uint32_t executed;
+    uint32_t failed;
+    uint32_t skipped;       // not run because a dependency failed
+    uint64_t steals;
+    double seconds;
+} sched_stats;
+
+// Mark every target reachable from 'roots' (inclusive)
+void sched_closure(const build_graph* graph, const uint32_t* roots, size_t num_roots, uint8_t* wanted);
+
+// Run the wanted targets in dependency order on a work-stealing pool
+int sched_run(const build_graph* graph, const uint8_t* wanted, const sched_options* options,
+              sched_task_fn task, void* ctx, sched_stats* stats);
+
+int sched_default_workers(void);
+
+#endif // SCALERUN_SCHEDULER_H
@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "state.h"
+#include "common.h"
+#include "md5.h"
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define STATE_FILE "build.state"
+#define STATE_HEADER "scalerun-state 2"
+
+static uint32_t hash_string(const char* str) {
+    uint32_t hash = 2166136261u;
+    for (; *str; str++) {
+        hash ^= (unsigned char)*str;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int parse_hex(const char* hex, uint8_t digest[16]) {
+    for (int i = 0; i < 16; i++) {
+        unsigned int byte;
+        if (sscanf(hex + i * 2, "%2x", &byte) != 1) return 0;
+        digest[i] = (uint8_t)byte;
+    }
+    return 1;
+}
+
+static void target_definition(const build_state* state, const build_graph* g, uint32_t t, uint8_t out[16]) {
+    md5_ctx md5;
+    md5_init(&md5);
+    md5_update(&md5, &state->digest_mode, 1);
+    md5_update(&md5, &g->kind[t], 1);
+
+    const char* fields[] = {graph_str(g, g->label[t]), graph_str(g, g->output[t]), graph_str(g, g->command[t])};
+    for (int i = 0; i < 3; i++) md5_update(&md5, fields[i], strlen(fields[i]) + 1);
+    for (uint32_t i = g->dep_index[t]; i < g->dep_index[t + 1]; i++) {
+        const char* label = graph_str(g, g->label[g->deps[i]]);
+        md5_update(&md5, label, strlen(label) + 1);
+    }
+    md5_update(&md5, "", 1);
+    for (uint32_t i = g->src_index[t]; i < g->src_index[t + 1]; i++) {
+        const char* path = graph_str(g, g->srcs[i]);
+        md5_update(&md5, path, strlen(path) + 1);
+    }
+    md5_final(&md5, out);
+}
+
+void state_stamp(file_stamp* stamp, const struct stat* st) {
+    stamp->mtime_ns = (int64_t)st->st_mtim.tv_sec * 1000000000 + st->st_mtim.tv_nsec;
+    stamp->size = (uint64_t)st->st_size;
+    stamp->ino = (uint64_t)st->st_ino;
+}
+
+build_state* state_load(const build_graph* graph, const char* state_dir) {
+    uint32_t num_files = graph->src_index[graph->num_targets];
+    build_state* state = xcalloc(1, sizeof(build_state));
+    state->stamp = xcalloc(num_files, sizeof(file_stamp));
+    state->file_digest = xcalloc(num_files, sizeof(*state->file_digest));
+    state->file_known = xcalloc(num_files, sizeof(uint8_t));
+    state->definition = xcalloc(graph->num_targets, sizeof(*state->definition));
+    state->digest = xcalloc(graph->num_targets, sizeof(*state->digest));
+    state->target_known = xcalloc(graph->num_targets, sizeof(uint8_t));
+
+    char path[PATH_MAX];
+    if (!join_path(path, sizeof(path), state_dir, STATE_FILE)) return state;
+    char* data = read_file(path, NULL);
+    if (!data) return state;
+
+    if (strncmp(data, STATE_HEADER "\n", strlen(STATE_HEADER) + 1) != 0) {
+        fprintf(stderr, "Warning: Ignoring %s from an incompatible version\n", path);
+        free(data);
+        return state;
+    }
+
+    // Source paths may repeat across targets; every slot with the path gets the record
+    uint32_t mask = 1023;
+    while (mask < num_files * 2) mask = mask * 2 + 1;
+    uint32_t* slots = xcalloc((size_t)mask + 1, sizeof(uint32_t));
+    for (uint32_t i = 0; i < num_files; i++) {
+        uint32_t h = hash_string(graph_str(graph, graph->srcs[i])) & mask;
+        while (slots[h]) h = (h + 1) & mask;
+        slots[h] = i + 1;
+    }
+
+    char* line = data + strlen(STATE_HEADER) + 1;
+    while (*line) {
+        char* end = strchr(line, '\n');
+        if (end) *end = '\0';
+
+        file_stamp stamp;
+        char hex[33], hex2[33];
+        int name_at = 0;
+        if (sscanf(line, "F %" SCNd64 " %" SCNu64 " %" SCNu64 " %32s %n", &stamp.mtime_ns, &stamp.size, &stamp.ino,
+                   hex, &name_at) == 4 && name_at) {
+            const char* name = line + name_at;
+            uint8_t digest[16];
+            uint32_t h = hash_string(name) & mask;
+            for (; parse_hex(hex, digest) && slots[h]; h = (h + 1) & mask) {
+                uint32_t i = slots[h] - 1;
+                if (strcmp(graph_str(graph, graph->srcs[i]), name) != 0) continue;
+                state->stamp[i] = stamp;
+                memcpy(state->file_digest[i], digest, 16);
+                state->file_known[i] = 1;
+            }
+        } else if (sscanf(line, "T %32s %32s %n", hex, hex2, &name_at) == 2 && name_at) {
+            int t = graph_find(graph, line + name_at);
+            if (t >= 0 && parse_hex(hex, state->definition[t]) && parse_hex(hex2, state->digest[t])) {
+                state->target_known[t] = 1;
+            }
+        }
+
+        if (!end) break;
+        line = end + 1;
+    }
+
+    free(slots);
+    free(data);
+    return state;
+}
+
+int state_save(const build_state* state, const build_graph* graph, const char* state_dir) {
+    char path[PATH_MAX], tmp[PATH_MAX];
+    if (!join_path(path, sizeof(path), state_dir, STATE_FILE) ||
+        !join_path(tmp, sizeof(tmp), state_dir, STATE_FILE ".tmp")) {
+        return 0;
+    }
+
+    FILE* file = fopen(tmp, "w");
+    if (!file) return 0;
+    fprintf(file, "%s\n", STATE_HEADER);
+
+    char hex[33], hex2[33];
+    for (uint32_t i = 0; i < graph->src_index[graph->num_targets]; i++) {
+        if (!state->file_known[i]) continue;
+        const file_stamp* s = &state->stamp[i];
+        md5_hex(state->file_digest[i], hex);
+        fprintf(file, "F %" PRId64 " %" PRIu64 " %" PRIu64 " %s %s\n", s->mtime_ns, s->size, s->ino, hex,
+                graph_str(graph, graph->srcs[i]));
+    }
+    for (uint32_t t = 0; t < graph->num_targets; t++) {
+        if (!state->target_known[t]) continue;
+        md5_hex(state->definition[t], hex);
+        md5_hex(state->digest[t], hex2);
+        fprintf(file, "T %s %s %s\n", hex, hex2, graph_str(graph, graph->label[t]));
+    }
+
+    int ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+    if (ok) ok = rename(tmp, path) == 0;
+    if (!ok) unlink(tmp);
+    return ok;
+}
+
+void state_free(build_state* state) {
+    if (!state) return;
+    free(state->stamp);
+    free(state->file_digest);
+    free(state->file_known);
+    free(state->definition);
+    free(state->digest);
+    free(state->target_known);
+    free(state);
+}
+
+// Has any source file of a shell_sources target changed? Files whose stamp
+// changed are re-hashed so a touch without an edit does not count.
+static int sources_changed(build_state* state, const build_graph* g, const char* root, uint32_t t,
+                           state_plan* plan) {
+    int changed = 0;
+    char path[PATH_MAX];
+
+    for (uint32_t i = g->src_index[t]; i < g->src_index[t + 1]; i++) {
+        struct stat st;
+        file_stamp stamp;
+        if (!join_path(path, sizeof(path), root, graph_str(g, g->srcs[i])) || stat(path, &st) != 0) {
+            changed = 1;
+            continue;
+        }
+        state_stamp(&stamp, &st);
+        if (state->file_known[i] && memcmp(&stamp, &state->stamp[i], sizeof(stamp)) == 0) continue;
+
+        plan->stat_changed++;
+        uint8_t digest[16];
+        if (!md5_file(path, digest)) {
+            changed = 1;
+            continue;
+        }
+        if (!state->file_known[i] || memcmp(digest, state->file_digest[i], 16) != 0) {
+            plan->content_changed++;
+            changed = 1;
+        }
+        state->stamp[i] = stamp;
+        memcpy(state->file_digest[i], digest, 16);
+        state->file_known[i] = 1;
+    }
+    return changed;
+}
+
+void state_dirty_cone(build_state* state, const build_graph* g, const char* root, const char* out_dir,
+                      const uint8_t* wanted, uint8_t* dirty, state_plan* plan) {
+    memset(plan, 0, sizeof(*plan));
+    uint32_t* queue = xmalloc((size_t)g->num_targets * sizeof(uint32_t));
+    size_t head = 0, tail = 0;
+    char path[PATH_MAX];
+
+    for (uint32_t t = 0; t < g->num_targets; t++) {
+        dirty[t] = 0;
+        if (!wanted[t]) continue;
+
+        int changed = !state->target_known[t];
+        if (!changed) {
+            uint8_t definition[16];
+            target_definition(state, g, t, definition);
+            changed = memcmp(definition, state->definition[t], 16) != 0;
+        }
+        if (g->kind[t] == TARGET_SOURCES && sources_changed(state, g, root, t, plan)) changed = 1;
+        if (g->kind[t] == TARGET_TOOL && !changed) {
+            struct stat st;
+            changed = !join_path(path, sizeof(path), out_dir, graph_str(g, g->output[t])) || stat(path, &st) != 0;
+        }
+
+        if (changed) {
+            dirty[t] = 1;
+            queue[tail++] = t;
+        }
+    }
+
+    // Everything downstream of a change has to run again
+    while (head < tail) {
+        uint32_t t = queue[head++];
+        for (uint32_t i = g->rdep_index[t]; i < g->rdep_index[t + 1]; i++) {
+            uint32_t dependent = g->rdeps[i];
+            if (!wanted[dependent] || dirty[dependent]) continue;
+            dirty[dependent] = 1;
+            queue[tail++] = dependent;
+        }
+    }
+    free(queue);
+
+    // A dirty target only becomes known again once it has been rebuilt
+    for (uint32_t t = 0; t < g->num_targets; t++) {
+        if (!wanted[t]) continue;
+        if (dirty[t]) {
+            state->target_known[t] = 0;
+            plan->dirty++;
+        } else {
+            plan->skipped++;
+        }
+    }
+}
+
+void state_record(build_state* state, const build_graph* graph, uint32_t target, const uint8_t digest[16]) {
+    target_definition(state, graph, target, state->definition[target]);
+    memcpy(state->digest[target], digest, 16);
+    state->target_known[target] = 1;
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef SCALERUN_STATE_H
+#define SCALERUN_STATE_H
+
+#include "graph.h"
+#include <stdint.h>
+#include <sys/stat.h>
+
+// What we remember about a source file between runs. No ctime: staging
+// sources into chroots hard-links them, which bumps their ctime.
+typedef struct {
+    int64_t mtime_ns;
+    uint64_t size;
+    uint64_t ino;
+} file_stamp;
+
+// Build state persisted in <state>/build.state. File records are indexed
+// like graph->srcs, target records like the graph's targets.
+typedef struct {
+    file_stamp* stamp;
+    uint8_t (*file_digest)[16];
+    uint8_t* file_known;
+
+    uint8_t (*definition)[16];  // md5 of the target's BUILD declaration and digest_mode
+    uint8_t (*digest)[16];      // see action_context.digest
+    uint8_t* target_known;
+
+    // Set by the caller before planning: the action mode whose digests this
+    // run produces. Modes hash tools differently, so a change dirties them.
+    uint8_t digest_mode;
+} build_state;
+
+typedef struct {
+    uint32_t stat_changed;      // source files whose stamp changed
+    uint32_t content_changed;   // ... and whose content changed too
+    uint32_t dirty;             // wanted targets that have to run
+    uint32_t skipped;           // wanted targets reused from the last run
+} state_plan;
+
+build_state* state_load(const build_graph* graph, const char* state_dir);
+int state_save(const build_state* state, const build_graph* graph, const char* state_dir);
+void state_free(build_state* state);
+
+void state_stamp(file_stamp* stamp, const struct stat* st);
+
+// Mark the wanted targets whose inputs changed since the last run, plus
+// everything that transitively depends on them
+void state_dirty_cone(build_state* state, const build_graph* graph, const char* root, const char* out_dir,
+                      const uint8_t* wanted, uint8_t* dirty, state_plan* plan);
+
+// Record a target that was built (or reused) in this run
+void state_record(build_state* state, const build_graph* graph, uint32_t target, const uint8_t digest[16]);
+
+#endif // SCALERUN_STATE_H
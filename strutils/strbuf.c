@@ -0,0 +1,211 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "strutils.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Largest precision strbuf_append_double honours; doubles carry no more
+// significant digits than this anyway
+#define STRBUF_MAX_PRECISION 15
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static char* strbuf_data(strbuf* buf) {
+    return buf->heap ? buf->heap : buf->inline_data;
+}
+
+void strbuf_init(strbuf* buf) {
+    if (!buf) return;
+    buf->heap = NULL;
+    buf->length = 0;
+    buf->capacity = STRBUF_INLINE_SIZE - 1;
+    buf->inline_data[0] = '\0';
+}
+
+void strbuf_free(strbuf* buf) {
+    if (!buf) return;
+    free(buf->heap);
+    strbuf_init(buf);
+}
+
+void strbuf_clear(strbuf* buf) {
+    if (!buf) return;
+    buf->length = 0;
+    strbuf_data(buf)[0] = '\0';
+}
+
+const char* strbuf_cstr(const strbuf* buf) {
+    if (!buf) return NULL;
+    return buf->heap ? buf->heap : buf->inline_data;
+}
+
+int strbuf_reserve(strbuf* buf, size_t extra) {
+    if (!buf) return 0;
+    if (extra <= buf->capacity - buf->length) return 1;
+    if (extra > SIZE_MAX - 1 - buf->length) return 0;
+
+    // Doubling keeps a long run of appends linear overall
+    size_t needed = buf->length + extra;
+    size_t capacity = buf->capacity;
+    while (capacity < needed) {
+        capacity = capacity > (SIZE_MAX - 1) / 2 ? needed : capacity * 2 + 1;
+    }
+
+    char* heap = realloc(buf->heap, capacity + 1);
+    if (!heap) return 0;
+    if (!buf->heap) {
+        memcpy(heap, buf->inline_data, buf->length + 1);
+    }
+    buf->heap = heap;
+    buf->capacity = capacity;
+    return 1;
+}
+
+int strbuf_append_n(strbuf* buf, const char* str, size_t len) {
+    if (!buf || (!str && len > 0)) return 0;
+    if (!strbuf_reserve(buf, len)) return 0;
+    char* data = strbuf_data(buf);
+    memcpy(data + buf->length, str, len);
+    buf->length += len;
+    data[buf->length] = '\0';
+    return 1;
+}
+
+int strbuf_append(strbuf* buf, const char* str) {
+    if (!str) return 0;
+    return strbuf_append_n(buf, str, strlen(str));
+}
+
+int strbuf_append_char(strbuf* buf, char ch) {
+    if (!strbuf_reserve(buf, 1)) return 0;
+    char* data = strbuf_data(buf);
+    data[buf->length++] = ch;
+    data[buf->length] = '\0';
+    return 1;
+}
+
+// Writes the decimal digits of value so that they end just before end and
+// returns where they start
+static char* strbuf_format_unsigned(char* end, uint64_t value) {
+    while (value >= 100) {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        end[0] = digit_pairs[pair];
+        end[1] = digit_pairs[pair + 1];
+    }
+    if (value >= 10) {
+        unsigned pair = (unsigned)value * 2;
+        end -= 2;
+        end[0] = digit_pairs[pair];
+        end[1] = digit_pairs[pair + 1];
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+int strbuf_append_int(strbuf* buf, long long value) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    // Negating in unsigned arithmetic also covers LLONG_MIN
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    char* start = strbuf_format_unsigned(end, magnitude);
+    if (value < 0) *--start = '-';
+    return strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+// Exact a * b - product, where product is a * b rounded (Dekker's product).
+// When the compiler may fuse multiply-adds it would break the splitting, but
+// then a real fma is available.
+static double strbuf_product_error(double a, double b, double product) {
+#ifdef __FP_FAST_FMA
+    return __builtin_fma(a, b, -product);
+#else
+    const double split = 134217729.0;  // 2^27 + 1
+    double a_big = a * split;
+    double a_high = a_big - (a_big - a);
+    double a_low = a - a_high;
+    double b_big = b * split;
+    double b_high = b_big - (b_big - b);
+    double b_low = b - b_high;
+    return ((a_high * b_high - product) + a_high * b_low + a_low * b_high) + a_low * b_low;
+#endif
+}
+
+int strbuf_append_double(strbuf* buf, double value, int precision) {
+    if (!buf) return 0;
+    if (precision < 0) precision = 0;
+    if (precision > STRBUF_MAX_PRECISION) precision = STRBUF_MAX_PRECISION;
+
+    if (isnan(value)) return strbuf_append_n(buf, "nan", 3);
+    if (isinf(value)) return value < 0 ? strbuf_append_n(buf, "-inf", 4) : strbuf_append_n(buf, "inf", 3);
+
+    uint64_t scale = 1;
+    for (int i = 0; i < precision; i++) scale *= 10;
+
+    double magnitude = fabs(value);
+    double scaled = magnitude * (double)scale;
+    if (scaled >= 4503599627370496.0) {
+        // Past 2^52 the scaled value has no fraction bits left to round;
+        // rare enough to leave to printf, which prints it exactly
+        char text[32 + 308 + STRBUF_MAX_PRECISION];
+        int len = snprintf(text, sizeof(text), "%.*f", precision, value);
+        if (len < 0 || (size_t)len >= sizeof(text)) return 0;
+        return strbuf_append_n(buf, text, (size_t)len);
+    }
+
+    // Round to nearest, ties to even, as printf does.  scaled is within half
+    // an ulp of the exact product, so only a fraction of exactly one half needs
+    // the rounding error to decide.
+    uint64_t fixed = (uint64_t)scaled;
+    double fraction_part = scaled - (double)fixed;
+    if (fraction_part > 0.5) {
+        fixed++;
+    } else if (fraction_part == 0.5) {
+        double error = strbuf_product_error(magnitude, (double)scale, scaled);
+        if (error > 0 || (error == 0 && (fixed & 1))) fixed++;
+    }
+    uint64_t whole = fixed / scale;
+    uint64_t fraction = fixed % scale;
+
+    char digits[48];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    if (precision > 0) {
+        start = strbuf_format_unsigned(end, fraction);
+        while (end - start < precision) *--start = '0';
+        *--start = '.';
+    }
+    start = strbuf_format_unsigned(start, whole);
+    if (signbit(value)) *--start = '-';
+    return strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+char* strbuf_detach(strbuf* buf) {
+    if (!buf) return NULL;
+    char* str = buf->heap;
+    if (!str) {
+        str = malloc(buf->length + 1);
+        if (!str) return NULL;
+        memcpy(str, buf->inline_data, buf->length + 1);
+    }
+    strbuf_init(buf);
+    return str;
+}
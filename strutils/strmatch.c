@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "strutils.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Transitions hold the target state's row offset into the table, so the
+// search loop needs no multiply; the top bit marks states that end a pattern
+#define MATCH_OUTPUT_FLAG 0x80000000u
+#define MATCH_ROW_MASK 0x7fffffffu
+
+struct str_matcher {
+    // Bytes that occur in no pattern share class 0, which keeps rows short
+    uint8_t byte_class[256];
+    size_t class_count;
+    size_t state_count;
+    // state_count rows of class_count transitions, the root first
+    uint32_t* table;
+    // Patterns ending in each state, its own and those of its suffixes
+    size_t* output_start;
+    size_t* outputs;
+    size_t* pattern_lengths;
+};
+
+void str_matcher_free(str_matcher* matcher) {
+    if (!matcher) return;
+    free(matcher->table);
+    free(matcher->output_start);
+    free(matcher->outputs);
+    free(matcher->pattern_lengths);
+    free(matcher);
+}
+
+str_matcher* str_matcher_create(const char* const* patterns, const size_t* lengths, size_t count) {
+    if (!patterns && count > 0) return NULL;
+
+    str_matcher* matcher = calloc(1, sizeof(str_matcher));
+    if (!matcher) return NULL;
+
+    matcher->pattern_lengths = malloc((count ? count : 1) * sizeof(size_t));
+    if (!matcher->pattern_lengths) {
+        str_matcher_free(matcher);
+        return NULL;
+    }
+
+    size_t total_length = 0;
+    size_t class_count = 1;
+    for (size_t p = 0; p < count; p++) {
+        if (!patterns[p]) {
+            str_matcher_free(matcher);
+            return NULL;
+        }
+        size_t len = lengths ? lengths[p] : strlen(patterns[p]);
+        matcher->pattern_lengths[p] = len;
+        total_length += len;
+        for (size_t i = 0; i < len; i++) {
+            uint8_t byte = (uint8_t)patterns[p][i];
+            if (!matcher->byte_class[byte]) matcher->byte_class[byte] = (uint8_t)class_count++;
+        }
+    }
+    // With all 256 byte values in use there is no spare class 0, and the
+    // last one wrapped to it; every byte then is its own class
+    if (class_count > 256) {
+        for (int byte = 0; byte < 256; byte++) matcher->byte_class[byte] = (uint8_t)byte;
+        class_count = 256;
+    }
+    matcher->class_count = class_count;
+
+    // The trie has at most one state per pattern byte, plus the root
+    size_t max_states = total_length + 1;
+    if (max_states > MATCH_ROW_MASK / class_count) {
+        str_matcher_free(matcher);
+        return NULL;
+    }
+    uint32_t* trie = calloc(max_states * class_count, sizeof(uint32_t));
+    size_t* terminal = calloc(max_states, sizeof(size_t));   // patterns ending here
+    size_t* terminal_next = malloc((count ? count : 1) * sizeof(size_t));
+    size_t* fail = calloc(max_states, sizeof(size_t));
+    size_t* order = malloc(max_states * sizeof(size_t));   // breadth-first queue
+    if (!trie || !terminal || !terminal_next || !fail || !order) goto fail;
+
+    // Build the trie; state 0 is the root, so 0 also means "no edge".
+    // terminal[s] is 1 + the first pattern ending at s, chained through
+    // terminal_next for duplicates.
+    size_t state_count = 1;
+    for (size_t p = 0; p < count; p++) {
+        size_t len = matcher->pattern_lengths[p];
+        // An empty pattern would match everywhere; it never matches instead
+        if (len == 0) continue;
+        size_t state = 0;
+        for (size_t i = 0; i < len; i++) {
+            uint32_t* edge = &trie[state * class_count + matcher->byte_class[(uint8_t)patterns[p][i]]];
+            if (!*edge) *edge = (uint32_t)state_count++;
+            state = *edge;
+        }
+        terminal_next[p] = terminal[state];
+        terminal[state] = p + 1;
+    }
+
+    // Breadth-first, so a state's failure link is finished before the state;
+    // missing edges are filled in from the failure state, turning the trie
+    // into a complete automaton
+    size_t head = 0, tail = 0;
+    order[tail++] = 0;
+    while (head < tail) {
+        size_t state = order[head++];
+        uint32_t* row = &trie[state * class_count];
+        const uint32_t* fail_row = &trie[fail[state] * class_count];
+        for (size_t c = 0; c < class_count; c++) {
+            // Only this state's own pass fills its row, so a nonzero edge
+            // here is still a trie child
+            if (row[c]) {
+                size_t child = row[c];
+                fail[child] = state == 0 ? 0 : fail_row[c];
+                order[tail++] = child;
+            } else {
+                row[c] = state == 0 ? 0 : fail_row[c];
+            }
+        }
+    }
+
+    // Collect outputs per state in breadth-first order: a state's own
+    // patterns, then everything its failure state reports
+    matcher->output_start = malloc((state_count + 1) * sizeof(size_t));
+    if (!matcher->output_start) goto fail;
+    size_t output_total = 0;
+    size_t* output_count = calloc(state_count, sizeof(size_t));
+    if (!output_count) goto fail;
+    for (size_t i = 0; i < state_count; i++) {
+        size_t state = order[i];
+        size_t own = 0;
+        for (size_t t = terminal[state]; t; t = terminal_next[t - 1]) own++;
+        output_count[state] = own + (state ? output_count[fail[state]] : 0);
+        output_total += output_count[state];
+    }
+    matcher->outputs = malloc((output_total ? output_total : 1) * sizeof(size_t));
+    if (!matcher->outputs) {
+        free(output_count);
+        goto fail;
+    }
+    size_t next = 0;
+    for (size_t state = 0; state < state_count; state++) {
+        matcher->output_start[state] = next;
+        next += output_count[state];
+    }
+    matcher->output_start[state_count] = next;
+    free(output_count);
+    for (size_t i = 0; i < state_count; i++) {
+        size_t state = order[i];
+        size_t* out = &matcher->outputs[matcher->output_start[state]];
+        for (size_t t = terminal[state]; t; t = terminal_next[t - 1]) *out++ = t - 1;
+        if (state) {
+            size_t f = fail[state];
+            size_t n = matcher->output_start[f + 1] - matcher->output_start[f];
+            memcpy(out, &matcher->outputs[matcher->output_start[f]], n * sizeof(size_t));
+        }
+    }
+
+    // Final table: row offsets instead of state numbers, flagged when the
+    // target state reports a pattern
+    matcher->table = malloc(state_count * class_count * sizeof(uint32_t));
+    if (!matcher->table) goto fail;
+    for (size_t i = 0; i < state_count * class_count; i++) {
+        size_t target = trie[i];
+        uint32_t value = (uint32_t)(target * class_count);
+        if (matcher->output_start[target + 1] != matcher->output_start[target]) value |= MATCH_OUTPUT_FLAG;
+        matcher->table[i] = value;
+    }
+    matcher->state_count = state_count;
+
+    free(trie);
+    free(terminal);
+    free(terminal_next);
+    free(fail);
+    free(order);
+    return matcher;
+
+fail:
+    free(trie);
+    free(terminal);
+    free(terminal_next);
+    free(fail);
+    free(order);
+    str_matcher_free(matcher);
+    return NULL;
+}
+
+size_t str_matcher_search(const str_matcher* matcher, const char* text, size_t len,
+                          str_match_callback callback, void* context) {
+    if (!matcher || (!text && len > 0)) return 0;
+
+    const uint32_t* table = matcher->table;
+    const uint8_t* byte_class = matcher->byte_class;
+    const uint8_t* bytes = (const uint8_t*)text;
+    size_t matches = 0;
+    uint32_t row = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t next = table[row + byte_class[bytes[i]]];
+        row = next & MATCH_ROW_MASK;
+        if (next & MATCH_OUTPUT_FLAG) {
+            size_t state = row / matcher->class_count;
+            for (size_t o = matcher->output_start[state]; o < matcher->output_start[state + 1]; o++) {
+                size_t pattern = matcher->outputs[o];
+                matches++;
+                if (callback && !callback(i + 1 - matcher->pattern_lengths[pattern], pattern, context)) {
+                    return matches;
+                }
+            }
+        }
+    }
+    return matches;
+}
+
+typedef struct {
+    str_match* matches;
+    size_t capacity;
+    size_t count;
+} match_collector;
+
+static int collect_match(size_t offset, size_t pattern, void* context) {
+    match_collector* collector = context;
+    if (collector->count < collector->capacity) {
+        collector->matches[collector->count].offset = offset;
+        collector->matches[collector->count].pattern = pattern;
+    }
+    collector->count++;
+    return 1;
+}
+
+size_t str_matcher_find_all(const str_matcher* matcher, const char* text, size_t len,
+                            str_match* matches, size_t max_matches) {
+    match_collector collector = { matches, matches ? max_matches : 0, 0 };
+    str_matcher_search(matcher, text, len, collect_match, &collector);
+    return collector.count;
+}
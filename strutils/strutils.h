@@ -23,10 +23,55 @@ char* str_find(const char* haystack, const char* needle);
 int str_replace(char* str, char old_char, char new_char);
 int str_count(const char* str, char ch);
 
+// Length-bounded forms: str need not be NUL-terminated
+size_t str_replace_n(char* str, size_t len, char old_char, char new_char);
+size_t str_count_n(const char* str, size_t len, char ch);
+
+// Multi-pattern search (Aho-Corasick); a matcher is read-only once created
+typedef struct str_matcher str_matcher;
+
+typedef struct {
+    size_t offset;
+    size_t pattern;
+} str_match;
+
+typedef int (*str_match_callback)(size_t offset, size_t pattern, void* context);
+
+str_matcher* str_matcher_create(const char* const* patterns, const size_t* lengths, size_t count);
+size_t str_matcher_search(const str_matcher* matcher, const char* text, size_t len,
+                          str_match_callback callback, void* context);
+size_t str_matcher_find_all(const str_matcher* matcher, const char* text, size_t len,
+                            str_match* matches, size_t max_matches);
+void str_matcher_free(str_matcher* matcher);
+
 // String validation
 int str_is_empty(const char* str);
 int str_is_numeric(const char* str);
 int str_is_alpha(const char* str);
+int str_is_numeric_n(const char* str, size_t len);
+int str_is_alpha_n(const char* str, size_t len);
+
+// String builder: appends return 0, changing nothing, when memory runs out
+#define STRBUF_INLINE_SIZE 64
+
+typedef struct {
+    char* heap;
+    size_t length;
+    size_t capacity;
+    char inline_data[STRBUF_INLINE_SIZE];
+} strbuf;
+
+void strbuf_init(strbuf* buf);
+void strbuf_free(strbuf* buf);
+void strbuf_clear(strbuf* buf);
+const char* strbuf_cstr(const strbuf* buf);
+int strbuf_reserve(strbuf* buf, size_t extra);
+int strbuf_append(strbuf* buf, const char* str);
+int strbuf_append_n(strbuf* buf, const char* str, size_t len);
+int strbuf_append_char(strbuf* buf, char ch);
+int strbuf_append_int(strbuf* buf, long long value);
+int strbuf_append_double(strbuf* buf, double value, int precision);
+char* strbuf_detach(strbuf* buf);
 
 // Memory management
 char* str_duplicate(const char* str);
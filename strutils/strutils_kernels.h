@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Vector scanning kernels, written once for every instruction set:
+// strutils_simd.c includes this file once per set, after defining VEC,
+// VEC_WIDTH, VEC_TARGET, KERNEL() and the vec_* operations for it.  There is
+// deliberately no include guard.
+//
+// The NUL-terminated kernels advance byte by byte to a VEC_WIDTH boundary and
+// then load whole aligned vectors.  An aligned vector never crosses a page, so
+// reading past the terminator is safe, but AddressSanitizer cannot know that.
+//
+// Byte-lane counters count down by one per match (a match compares as -1)
+// and are summed every 255 vectors, before a lane can wrap.
+
+#define VEC_ALIGNED(p) ((uintptr_t)(p) % VEC_WIDTH == 0)
+
+// Bits of mask below the lowest set bit of nul, i.e. the bytes before the
+// terminator
+#define BEFORE_NUL(mask, nul) ((mask) & ((nul) - 1) & ~(nul))
+
+static VEC_TARGET KERNEL_NO_ASAN size_t KERNEL(length)(const char* str) {
+    const char* p = str;
+    while (!VEC_ALIGNED(p)) {
+        if (*p == '\0') return (size_t)(p - str);
+        p++;
+    }
+    VEC zero = vec_zero();
+    for (;; p += VEC_WIDTH) {
+        unsigned nul = vec_mask(vec_cmpeq(vec_load(p), zero));
+        if (nul) return (size_t)(p - str) + (size_t)__builtin_ctz(nul);
+    }
+}
+
+static VEC_TARGET KERNEL_NO_ASAN size_t KERNEL(count)(const char* str, char ch) {
+    size_t count = 0;
+    const char* p = str;
+    while (!VEC_ALIGNED(p)) {
+        if (*p == '\0') return count;
+        count += *p == ch;
+        p++;
+    }
+    VEC zero = vec_zero();
+    VEC needle = vec_set1(ch);
+    for (;;) {
+        VEC counters = vec_zero();
+        for (int i = 0; i < 255; i++, p += VEC_WIDTH) {
+            VEC v = vec_load(p);
+            VEC hits = vec_cmpeq(v, needle);
+            unsigned nul = vec_mask(vec_cmpeq(v, zero));
+            if (nul) {
+                count += vec_sum_u8(counters);
+                return count + (size_t)__builtin_popcount(BEFORE_NUL(vec_mask(hits), nul));
+            }
+            counters = vec_sub8(counters, hits);
+        }
+        count += vec_sum_u8(counters);
+    }
+}
+
+static VEC_TARGET size_t KERNEL(count_n)(const char* str, size_t len, char ch) {
+    size_t count = 0;
+    size_t i = 0;
+    VEC needle = vec_set1(ch);
+    while (len - i >= VEC_WIDTH) {
+        size_t vectors = (len - i) / VEC_WIDTH;
+        if (vectors > 255) vectors = 255;
+        VEC counters = vec_zero();
+        for (size_t v = 0; v < vectors; v++, i += VEC_WIDTH) {
+            counters = vec_sub8(counters, vec_cmpeq(vec_loadu(str + i), needle));
+        }
+        count += vec_sum_u8(counters);
+    }
+    for (; i < len; i++) {
+        count += str[i] == ch;
+    }
+    return count;
+}
+
+static VEC_TARGET KERNEL_NO_ASAN size_t KERNEL(replace)(char* str, char old_char, char new_char) {
+    // The terminator is never replaced
+    if (old_char == '\0') return 0;
+
+    size_t count = 0;
+    char* p = str;
+    while (!VEC_ALIGNED(p)) {
+        if (*p == '\0') return count;
+        if (*p == old_char) {
+            *p = new_char;
+            count++;
+        }
+        p++;
+    }
+    VEC zero = vec_zero();
+    VEC from = vec_set1(old_char);
+    VEC to = vec_set1(new_char);
+    for (;;) {
+        VEC counters = vec_zero();
+        for (int i = 0; i < 255; i++, p += VEC_WIDTH) {
+            VEC v = vec_load(p);
+            VEC hits = vec_cmpeq(v, from);
+            unsigned nul = vec_mask(vec_cmpeq(v, zero));
+            if (nul) {
+                unsigned mask = BEFORE_NUL(vec_mask(hits), nul);
+                count += vec_sum_u8(counters) + (size_t)__builtin_popcount(mask);
+                for (; mask; mask &= mask - 1) {
+                    p[__builtin_ctz(mask)] = new_char;
+                }
+                return count;
+            }
+            // Untouched vectors are not written back
+            if (vec_mask(hits)) {
+                vec_store(p, vec_or(vec_and(hits, to), vec_andnot(hits, v)));
+                counters = vec_sub8(counters, hits);
+            }
+        }
+        count += vec_sum_u8(counters);
+    }
+}
+
+static VEC_TARGET size_t KERNEL(replace_n)(char* str, size_t len, char old_char, char new_char) {
+    size_t count = 0;
+    size_t i = 0;
+    VEC from = vec_set1(old_char);
+    VEC to = vec_set1(new_char);
+    while (len - i >= VEC_WIDTH) {
+        size_t vectors = (len - i) / VEC_WIDTH;
+        if (vectors > 255) vectors = 255;
+        VEC counters = vec_zero();
+        for (size_t n = 0; n < vectors; n++, i += VEC_WIDTH) {
+            VEC v = vec_loadu(str + i);
+            VEC hits = vec_cmpeq(v, from);
+            if (vec_mask(hits)) {
+                vec_storeu(str + i, vec_or(vec_and(hits, to), vec_andnot(hits, v)));
+                counters = vec_sub8(counters, hits);
+            }
+        }
+        count += vec_sum_u8(counters);
+    }
+    for (; i < len; i++) {
+        if (str[i] == old_char) {
+            str[i] = new_char;
+            count++;
+        }
+    }
+    return count;
+}
+
+// A byte is in [lo, lo + span] when byte - lo, taken as unsigned, is at most
+// span; min(x, span) == x tests that without an unsigned compare
+#define VEC_IN_RANGE(v, lo, span) \
+    vec_cmpeq(vec_min_u8(vec_sub8((v), vec_set1(lo)), vec_set1(span)), vec_sub8((v), vec_set1(lo)))
+#define VEC_IS_DIGIT(v) VEC_IN_RANGE((v), '0', 9)
+// Setting bit 5 folds 'A'-'Z' onto 'a'-'z'
+#define VEC_IS_ALPHA(v) VEC_IN_RANGE(vec_or((v), vec_set1(0x20)), 'a', 25)
+
+#define DEFINE_CLASS_KERNELS(name, vec_ok, byte_ok)                                         \
+    static VEC_TARGET KERNEL_NO_ASAN int KERNEL(name)(const char* str) {                    \
+        const char* p = str;                                                                \
+        if (*p == '\0') return 0;                                                           \
+        while (!VEC_ALIGNED(p)) {                                                           \
+            if (*p == '\0') return 1;                                                       \
+            if (!byte_ok(*p)) return 0;                                                     \
+            p++;                                                                            \
+        }                                                                                   \
+        VEC zero = vec_zero();                                                              \
+        for (;; p += VEC_WIDTH) {                                                           \
+            VEC v = vec_load(p);                                                            \
+            unsigned bad = ~vec_mask(vec_ok(v)) & VEC_FULL_MASK;                            \
+            unsigned nul = vec_mask(vec_cmpeq(v, zero));                                    \
+            if (nul) return BEFORE_NUL(bad, nul) == 0;                                      \
+            if (bad) return 0;                                                              \
+        }                                                                                   \
+    }                                                                                       \
+                                                                                            \
+    static VEC_TARGET int KERNEL(name##_n)(const char* str, size_t len) {                   \
+        if (len == 0) return 0;                                                             \
+        size_t i = 0;                                                                       \
+        for (; len - i >= VEC_WIDTH; i += VEC_WIDTH) {                                      \
+            if (vec_mask(vec_ok(vec_loadu(str + i))) != VEC_FULL_MASK) return 0;            \
+        }                                                                                   \
+        for (; i < len; i++) {                                                              \
+            if (!byte_ok(str[i])) return 0;                                                 \
+        }                                                                                   \
+        return 1;                                                                           \
+    }
+
+DEFINE_CLASS_KERNELS(is_numeric, VEC_IS_DIGIT, BYTE_IS_DIGIT)
+DEFINE_CLASS_KERNELS(is_alpha, VEC_IS_ALPHA, BYTE_IS_ALPHA)
+
+#undef DEFINE_CLASS_KERNELS
+#undef VEC_IS_ALPHA
+#undef VEC_IS_DIGIT
+#undef VEC_IN_RANGE
+#undef BEFORE_NUL
+#undef VEC_ALIGNED
@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "strutils.h"
+#include <stdint.h>
+
+// ASCII classes, matching isdigit/isalpha in the C locale
+#define BYTE_IS_DIGIT(c) ((unsigned char)((c) - '0') <= 9)
+#define BYTE_IS_ALPHA(c) ((unsigned char)(((c) | 0x20) - 'a') <= 25)
+
+#if defined(__x86_64__)
+
+#include <immintrin.h>
+
+#define KERNEL_NO_ASAN __attribute__((no_sanitize_address))
+
+// SSE2 is part of x86-64, so these kernels need no check
+#define VEC __m128i
+#define VEC_WIDTH 16
+#define VEC_FULL_MASK 0xffffu
+#define VEC_TARGET
+#define KERNEL(name) name##_sse2
+#define vec_load(p) _mm_load_si128((const __m128i*)(p))
+#define vec_loadu(p) _mm_loadu_si128((const __m128i*)(p))
+#define vec_store(p, v) _mm_store_si128((__m128i*)(p), (v))
+#define vec_storeu(p, v) _mm_storeu_si128((__m128i*)(p), (v))
+#define vec_zero() _mm_setzero_si128()
+#define vec_set1(c) _mm_set1_epi8((char)(c))
+#define vec_cmpeq(a, b) _mm_cmpeq_epi8((a), (b))
+#define vec_mask(v) ((unsigned)_mm_movemask_epi8(v))
+#define vec_sub8(a, b) _mm_sub_epi8((a), (b))
+#define vec_min_u8(a, b) _mm_min_epu8((a), (b))
+#define vec_or(a, b) _mm_or_si128((a), (b))
+#define vec_and(a, b) _mm_and_si128((a), (b))
+#define vec_andnot(a, b) _mm_andnot_si128((a), (b))
+
+static inline size_t vec_sum_u8(__m128i v) {
+    __m128i sums = _mm_sad_epu8(v, _mm_setzero_si128());
+    return (size_t)_mm_cvtsi128_si64(sums) + (size_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums));
+}
+
+#include "strutils_kernels.h"
+
+#undef VEC
+#undef VEC_WIDTH
+#undef VEC_FULL_MASK
+#undef VEC_TARGET
+#undef KERNEL
+#undef vec_load
+#undef vec_loadu
+#undef vec_store
+#undef vec_storeu
+#undef vec_zero
+#undef vec_set1
+#undef vec_cmpeq
+#undef vec_mask
+#undef vec_sub8
+#undef vec_min_u8
+#undef vec_or
+#undef vec_and
+#undef vec_andnot
+#define vec_sum_u8 vec_sum_u8_avx2
+
+#define VEC __m256i
+#define VEC_WIDTH 32
+#define VEC_FULL_MASK 0xffffffffu
+#define VEC_TARGET __attribute__((target("avx2,popcnt")))
+#define KERNEL(name) name##_avx2
+#define vec_load(p) _mm256_load_si256((const __m256i*)(p))
+#define vec_loadu(p) _mm256_loadu_si256((const __m256i*)(p))
+#define vec_store(p, v) _mm256_store_si256((__m256i*)(p), (v))
+#define vec_storeu(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+#define vec_zero() _mm256_setzero_si256()
+#define vec_set1(c) _mm256_set1_epi8((char)(c))
+#define vec_cmpeq(a, b) _mm256_cmpeq_epi8((a), (b))
+#define vec_mask(v) ((unsigned)_mm256_movemask_epi8(v))
+#define vec_sub8(a, b) _mm256_sub_epi8((a), (b))
+#define vec_min_u8(a, b) _mm256_min_epu8((a), (b))
+#define vec_or(a, b) _mm256_or_si256((a), (b))
+#define vec_and(a, b) _mm256_and_si256((a), (b))
+#define vec_andnot(a, b) _mm256_andnot_si256((a), (b))
+
+static inline VEC_TARGET size_t vec_sum_u8_avx2(__m256i v) {
+    __m256i sums = _mm256_sad_epu8(v, _mm256_setzero_si256());
+    __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return (size_t)_mm_cvtsi128_si64(halves) + (size_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(halves, halves));
+}
+
+#include "strutils_kernels.h"
+
+// Each kernel is bound to its AVX2 or SSE2 version once, when the library is
+// loaded, through an ifunc resolver.  Resolvers run during relocation, before
+// sanitizer runtimes are set up, so they must not be instrumented.
+static KERNEL_NO_ASAN int cpu_has_avx2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+
+#define DISPATCH(name, ret, params)                                          \
+    static KERNEL_NO_ASAN ret (*resolve_##name(void))params {               \
+        return cpu_has_avx2() ? name##_avx2 : name##_sse2;                  \
+    }                                                                        \
+    static ret name##_kernel params __attribute__((ifunc("resolve_" #name)));
+
+DISPATCH(length, size_t, (const char*))
+DISPATCH(count, size_t, (const char*, char))
+DISPATCH(count_n, size_t, (const char*, size_t, char))
+DISPATCH(replace, size_t, (char*, char, char))
+DISPATCH(replace_n, size_t, (char*, size_t, char, char))
+DISPATCH(is_numeric, int, (const char*))
+DISPATCH(is_numeric_n, int, (const char*, size_t))
+DISPATCH(is_alpha, int, (const char*))
+DISPATCH(is_alpha_n, int, (const char*, size_t))
+
+#else
+
+// Portable byte-at-a-time kernels for other architectures
+static size_t length_kernel(const char* str) {
+    size_t len = 0;
+    while (str[len] != '\0') len++;
+    return len;
+}
+
+static size_t count_kernel(const char* str, char ch) {
+    size_t count = 0;
+    for (; *str; str++) count += *str == ch;
+    return count;
+}
+
+static size_t count_n_kernel(const char* str, size_t len, char ch) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) count += str[i] == ch;
+    return count;
+}
+
+static size_t replace_n_kernel(char* str, size_t len, char old_char, char new_char) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (str[i] == old_char) {
+            str[i] = new_char;
+            count++;
+        }
+    }
+    return count;
+}
+
+static size_t replace_kernel(char* str, char old_char, char new_char) {
+    return replace_n_kernel(str, length_kernel(str), old_char, new_char);
+}
+
+static int is_numeric_n_kernel(const char* str, size_t len) {
+    if (len == 0) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!BYTE_IS_DIGIT(str[i])) return 0;
+    }
+    return 1;
+}
+
+static int is_numeric_kernel(const char* str) {
+    return is_numeric_n_kernel(str, length_kernel(str));
+}
+
+static int is_alpha_n_kernel(const char* str, size_t len) {
+    if (len == 0) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!BYTE_IS_ALPHA(str[i])) return 0;
+    }
+    return 1;
+}
+
+static int is_alpha_kernel(const char* str) {
+    return is_alpha_n_kernel(str, length_kernel(str));
+}
+
+#endif
+
+size_t str_length(const char* str) {
+    if (!str) return 0;
+    return length_kernel(str);
+}
+
+int str_replace(char* str, char old_char, char new_char) {
+    if (!str) return 0;
+    return (int)replace_kernel(str, old_char, new_char);
+}
+
+size_t str_replace_n(char* str, size_t len, char old_char, char new_char) {
+    if (!str) return 0;
+    return replace_n_kernel(str, len, old_char, new_char);
+}
+
+int str_count(const char* str, char ch) {
+    if (!str) return 0;
+    return (int)count_kernel(str, ch);
+}
+
+size_t str_count_n(const char* str, size_t len, char ch) {
+    if (!str) return 0;
+    return count_n_kernel(str, len, ch);
+}
+
+int str_is_numeric(const char* str) {
+    if (!str) return 0;
+    return is_numeric_kernel(str);
+}
+
+int str_is_numeric_n(const char* str, size_t len) {
+    if (!str) return 0;
+    return is_numeric_n_kernel(str, len);
+}
+
+int str_is_alpha(const char* str) {
+    if (!str) return 0;
+    return is_alpha_kernel(str);
+}
+
+int str_is_alpha_n(const char* str, size_t len) {
+    if (!str) return 0;
+    return is_alpha_n_kernel(str, len);
+}
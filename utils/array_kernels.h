@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Int array kernels, included by array_simd.c once per instruction set.
+// Whole vectors only; the remaining ints go through a plain loop.
+
+static VEC_TARGET void KERNEL(fill)(int* arr, size_t size, int value) {
+    VEC v = vec_set1(value);
+    size_t i = 0;
+    for (; i + 2 * VEC_INTS <= size; i += 2 * VEC_INTS) {
+        vec_storeu(arr + i, v);
+        vec_storeu(arr + i + VEC_INTS, v);
+    }
+    for (; i < size; i++) {
+        arr[i] = value;
+    }
+}
+
+// Swaps a vector from the front with one from the back, reversing the lanes
+// of both, until the two ends meet
+static VEC_TARGET void KERNEL(reverse)(int* arr, size_t size) {
+    size_t front = 0;
+    size_t back = size;
+    while (back - front >= 2 * VEC_INTS) {
+        back -= VEC_INTS;
+        VEC head = vec_loadu(arr + front);
+        VEC tail = vec_loadu(arr + back);
+        vec_storeu(arr + front, vec_reverse(tail));
+        vec_storeu(arr + back, vec_reverse(head));
+        front += VEC_INTS;
+    }
+    while (back - front > 1) {
+        back--;
+        int temp = arr[front];
+        arr[front] = arr[back];
+        arr[back] = temp;
+        front++;
+    }
+}
+
+// vec_mask has four bits per int lane, so a lane index is a bit index / 4
+static VEC_TARGET size_t KERNEL(find)(const int* arr, size_t size, int value) {
+    VEC needle = vec_set1(value);
+    size_t i = 0;
+    for (; i + 2 * VEC_INTS <= size; i += 2 * VEC_INTS) {
+        unsigned low = vec_mask(vec_cmpeq(vec_loadu(arr + i), needle));
+        unsigned high = vec_mask(vec_cmpeq(vec_loadu(arr + i + VEC_INTS), needle));
+        if (low | high) {
+            return low ? i + __builtin_ctz(low) / 4 : i + VEC_INTS + __builtin_ctz(high) / 4;
+        }
+    }
+    for (; i < size; i++) {
+        if (arr[i] == value) return i;
+    }
+    return size;
+}
+
+static VEC_TARGET long long KERNEL(sum)(const int* arr, size_t size) {
+    // Widening each vector to 64-bit lanes means the sum cannot overflow
+    VEC low = vec_zero();
+    VEC high = vec_zero();
+    size_t i = 0;
+    for (; i + VEC_INTS <= size; i += VEC_INTS) {
+        vec_add_widened(&low, &high, vec_loadu(arr + i));
+    }
+    long long sum = vec_sum64(vec_add64(low, high));
+    for (; i < size; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+static VEC_TARGET void KERNEL(min_max)(const int* arr, size_t size, int* min, int* max) {
+    size_t i = 0;
+    int lo = arr[0];
+    int hi = arr[0];
+    if (size >= VEC_INTS) {
+        VEC vmin = vec_loadu(arr);
+        VEC vmax = vmin;
+        for (i = VEC_INTS; i + VEC_INTS <= size; i += VEC_INTS) {
+            VEC v = vec_loadu(arr + i);
+            vmin = vec_min32(vmin, v);
+            vmax = vec_max32(vmax, v);
+        }
+        int lanes[VEC_INTS];
+        vec_storeu(lanes, vmin);
+        lo = lanes[0];
+        for (int l = 1; l < VEC_INTS; l++) lo = lanes[l] < lo ? lanes[l] : lo;
+        vec_storeu(lanes, vmax);
+        hi = lanes[0];
+        for (int l = 1; l < VEC_INTS; l++) hi = lanes[l] > hi ? lanes[l] : hi;
+    }
+    for (; i < size; i++) {
+        lo = arr[i] < lo ? arr[i] : lo;
+        hi = arr[i] > hi ? arr[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+static VEC_TARGET size_t KERNEL(count_eq)(const int* arr, size_t size, int value) {
+    VEC needle = vec_set1(value);
+    size_t count = 0;
+    size_t i = 0;
+    while (i + VEC_INTS <= size) {
+        // A match compares as -1, so the 32-bit lane counters count down;
+        // they are summed well before they could wrap
+        size_t vectors = (size - i) / VEC_INTS;
+        if (vectors > (1u << 30)) vectors = 1u << 30;
+        VEC counters = vec_zero();
+        for (size_t v = 0; v < vectors; v++, i += VEC_INTS) {
+            counters = vec_sub32(counters, vec_cmpeq(vec_loadu(arr + i), needle));
+        }
+        int lanes[VEC_INTS];
+        vec_storeu(lanes, counters);
+        for (int l = 0; l < VEC_INTS; l++) count += (unsigned)lanes[l];
+    }
+    for (; i < size; i++) {
+        count += arr[i] == value;
+    }
+    return count;
+}
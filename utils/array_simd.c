@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "utils.h"
+
+#if defined(__x86_64__)
+
+#include <immintrin.h>
+
+// Dispatched as in strutils/strutils_simd.c: array_kernels.h is built for
+// SSE2 and for AVX2, and an ifunc picks one per kernel at load time.
+
+// SSE2 has no 32-bit min/max or sign extension; they are built from compares
+#define VEC __m128i
+#define VEC_INTS 4
+#define VEC_TARGET
+#define KERNEL(name) name##_sse2
+#define vec_loadu(p) _mm_loadu_si128((const __m128i*)(p))
+#define vec_storeu(p, v) _mm_storeu_si128((__m128i*)(p), (v))
+#define vec_zero() _mm_setzero_si128()
+#define vec_set1(x) _mm_set1_epi32(x)
+#define vec_cmpeq(a, b) _mm_cmpeq_epi32((a), (b))
+#define vec_mask(v) ((unsigned)_mm_movemask_epi8(v))
+#define vec_sub32(a, b) _mm_sub_epi32((a), (b))
+#define vec_add64(a, b) _mm_add_epi64((a), (b))
+#define vec_reverse(v) _mm_shuffle_epi32((v), _MM_SHUFFLE(0, 1, 2, 3))
+#define vec_add_widened add_widened_sse2
+#define vec_sum64 sum64_sse2
+#define vec_min32 min32_sse2
+#define vec_max32 max32_sse2
+
+static inline void add_widened_sse2(__m128i* low, __m128i* high, __m128i v) {
+    __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+    *low = _mm_add_epi64(*low, _mm_unpacklo_epi32(v, sign));
+    *high = _mm_add_epi64(*high, _mm_unpackhi_epi32(v, sign));
+}
+
+static inline long long sum64_sse2(__m128i v) {
+    return _mm_cvtsi128_si64(v) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v));
+}
+
+static inline __m128i min32_sse2(__m128i a, __m128i b) {
+    __m128i a_greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(a_greater, b), _mm_andnot_si128(a_greater, a));
+}
+
+static inline __m128i max32_sse2(__m128i a, __m128i b) {
+    __m128i a_greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(a_greater, a), _mm_andnot_si128(a_greater, b));
+}
+
+#include "array_kernels.h"
+
+#undef VEC
+#undef VEC_INTS
+#undef VEC_TARGET
+#undef KERNEL
+#undef vec_loadu
+#undef vec_storeu
+#undef vec_zero
+#undef vec_set1
+#undef vec_cmpeq
+#undef vec_mask
+#undef vec_sub32
+#undef vec_add64
+#undef vec_reverse
+#undef vec_add_widened
+#undef vec_sum64
+#undef vec_min32
+#undef vec_max32
+
+#define VEC __m256i
+#define VEC_INTS 8
+#define VEC_TARGET __attribute__((target("avx2")))
+#define KERNEL(name) name##_avx2
+#define vec_loadu(p) _mm256_loadu_si256((const __m256i*)(p))
+#define vec_storeu(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+#define vec_zero() _mm256_setzero_si256()
+#define vec_set1(x) _mm256_set1_epi32(x)
+#define vec_cmpeq(a, b) _mm256_cmpeq_epi32((a), (b))
+#define vec_mask(v) ((unsigned)_mm256_movemask_epi8(v))
+#define vec_sub32(a, b) _mm256_sub_epi32((a), (b))
+#define vec_add64(a, b) _mm256_add_epi64((a), (b))
+#define vec_reverse(v) _mm256_permutevar8x32_epi32((v), _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0))
+#define vec_add_widened add_widened_avx2
+#define vec_sum64 sum64_avx2
+#define vec_min32(a, b) _mm256_min_epi32((a), (b))
+#define vec_max32(a, b) _mm256_max_epi32((a), (b))
+
+static inline VEC_TARGET void add_widened_avx2(__m256i* low, __m256i* high, __m256i v) {
+    *low = _mm256_add_epi64(*low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    *high = _mm256_add_epi64(*high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+
+static inline VEC_TARGET long long sum64_avx2(__m256i v) {
+    __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(halves) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(halves, halves));
+}
+
+#include "array_kernels.h"
+
+static __attribute__((no_sanitize_address)) int cpu_has_avx2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#define DISPATCH(name, ret, params)                                          \
+    static __attribute__((no_sanitize_address)) ret (*resolve_##name(void))params { \
+        return cpu_has_avx2() ? name##_avx2 : name##_sse2;                  \
+    }                                                                        \
+    static ret name##_kernel params __attribute__((ifunc("resolve_" #name)));
+
+DISPATCH(fill, void, (int*, size_t, int))
+DISPATCH(reverse, void, (int*, size_t))
+DISPATCH(find, size_t, (const int*, size_t, int))
+DISPATCH(sum, long long, (const int*, size_t))
+DISPATCH(min_max, void, (const int*, size_t, int*, int*))
+DISPATCH(count_eq, size_t, (const int*, size_t, int))
+
+#else
+
+// Portable kernels for other architectures, which compilers may still
+// auto-vectorize
+static void fill_kernel(int* arr, size_t size, int value) {
+    for (size_t i = 0; i < size; i++) arr[i] = value;
+}
+
+static void reverse_kernel(int* arr, size_t size) {
+    for (size_t i = 0; i < size / 2; i++) {
+        int temp = arr[i];
+        arr[i] = arr[size - 1 - i];
+        arr[size - 1 - i] = temp;
+    }
+}
+
+static size_t find_kernel(const int* arr, size_t size, int value) {
+    for (size_t i = 0; i < size; i++) {
+        if (arr[i] == value) return i;
+    }
+    return size;
+}
+
+static long long sum_kernel(const int* arr, size_t size) {
+    long long sum = 0;
+    for (size_t i = 0; i < size; i++) sum += arr[i];
+    return sum;
+}
+
+static void min_max_kernel(const int* arr, size_t size, int* min, int* max) {
+    int lo = arr[0], hi = arr[0];
+    for (size_t i = 1; i < size; i++) {
+        lo = arr[i] < lo ? arr[i] : lo;
+        hi = arr[i] > hi ? arr[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+static size_t count_eq_kernel(const int* arr, size_t size, int value) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++) count += arr[i] == value;
+    return count;
+}
+
+#endif
+
+void array_fill(int* arr, size_t size, int value) {
+    if (!arr) return;
+    fill_kernel(arr, size, value);
+}
+
+void array_reverse(int* arr, size_t size) {
+    if (!arr || size <= 1) return;
+    reverse_kernel(arr, size);
+}
+
+int array_find(int* arr, size_t size, int value) {
+    if (!arr) return -1;
+    size_t index = find_kernel(arr, size, value);
+    return index < size ? (int)index : -1;
+}
+
+long long array_sum(const int* arr, size_t size) {
+    if (!arr) return 0;
+    return sum_kernel(arr, size);
+}
+
+int array_min_max(const int* arr, size_t size, int* min, int* max) {
+    if (!arr || size == 0 || !min || !max) return 0;
+    min_max_kernel(arr, size, min, max);
+    return 1;
+}
+
+size_t array_count_eq(const int* arr, size_t size, int value) {
+    if (!arr) return 0;
+    return count_eq_kernel(arr, size, value);
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Nanoseconds per element for sorting random ints, at sizes 10 to max_size
+// by factors of 10: the bubble sort array_sort used to be (only up to 10k),
+// libc qsort as a reference, array_sort and array_sort_parallel.  Every
+// result is checked against qsort's.
+//
+// Usage: bench_sort [max_size] [threads]
+
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BUBBLE_MAX_SIZE 10000
+// Small sizes repeat until about this many elements have been sorted
+#define MIN_ELEMENTS_PER_SIZE 1000000
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bubble_sort(int* arr, size_t size) {
+    for (size_t i = 0; i + 1 < size; i++) {
+        for (size_t j = 0; j < size - i - 1; j++) {
+            if (arr[j] > arr[j + 1]) {
+                int temp = arr[j];
+                arr[j] = arr[j + 1];
+                arr[j + 1] = temp;
+            }
+        }
+    }
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int threads;
+
+static void run_qsort(int* arr, size_t size) {
+    qsort(arr, size, sizeof(int), compare_ints);
+}
+
+static void run_parallel(int* arr, size_t size) {
+    array_sort_parallel(arr, size, threads);
+}
+
+// Nanoseconds per element, or a negative number if the output was wrong
+static double bench(void (*sort)(int*, size_t), const int* input, const int* expected, int* work, size_t size,
+                    size_t reps) {
+    double elapsed = 0;
+    for (size_t r = 0; r < reps; r++) {
+        memcpy(work, input, size * sizeof(int));
+        double start = now();
+        sort(work, size);
+        elapsed += now() - start;
+    }
+    if (memcmp(work, expected, size * sizeof(int)) != 0) return -1;
+    return elapsed * 1e9 / ((double)size * (double)reps);
+}
+
+static void print_result(double ns) {
+    if (ns < 0) {
+        printf(" %12s", "WRONG");
+    } else {
+        printf(" %12.2f", ns);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_size = argc > 1 ? strtoull(argv[1], NULL, 10) : 100000000;
+    threads = argc > 2 ? atoi(argv[2]) : 0;
+
+    int* input = malloc(max_size * sizeof(int));
+    int* expected = malloc(max_size * sizeof(int));
+    int* work = malloc(max_size * sizeof(int));
+    if (!input || !expected || !work) {
+        fprintf(stderr, "Error: cannot allocate three arrays of %zu ints\n", max_size);
+        return 1;
+    }
+
+    random_seed(12345);
+    printf("%12s %12s %12s %12s %12s   (ns per element)\n", "size", "bubble", "qsort", "array_sort", "parallel");
+    int failed = 0;
+    for (size_t size = 10; size <= max_size; size *= 10) {
+        for (size_t i = 0; i < size; i++) {
+            input[i] = (int)((unsigned)rand() << 16 ^ (unsigned)rand());
+        }
+        memcpy(expected, input, size * sizeof(int));
+        run_qsort(expected, size);
+
+        size_t reps = size < MIN_ELEMENTS_PER_SIZE ? MIN_ELEMENTS_PER_SIZE / size : 1;
+        printf("%12zu", size);
+        if (size <= BUBBLE_MAX_SIZE) {
+            size_t bubble_reps = reps > 10 ? 10 : reps;
+            double ns = bench(bubble_sort, input, expected, work, size, bubble_reps);
+            print_result(ns);
+            failed |= ns < 0;
+        } else {
+            printf(" %12s", "-");
+        }
+        double results[3] = {
+            bench(run_qsort, input, expected, work, size, reps),
+            bench(array_sort, input, expected, work, size, reps),
+            bench(run_parallel, input, expected, work, size, reps),
+        };
+        for (int i = 0; i < 3; i++) {
+            print_result(results[i]);
+            failed |= results[i] < 0;
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    free(input);
+    free(expected);
+    free(work);
+    return failed;
+}
@@ -10,6 +10,7 @@
 #include <time.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <stdint.h>
 
 // Memory utilities
 void* safe_malloc(size_t size) {
@@ -45,48 +46,91 @@ void safe_free(void* ptr) {
     }
 }
 
-// Array utilities
-void array_fill(int* arr, size_t size, int value) {
-    if (!arr) return;
-    for (size_t i = 0; i < size; i++) {
-        arr[i] = value;
-    }
+// Arena utilities
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+struct arena_block {
+    arena_block* next;
+    size_t size;
+    size_t used;
+    max_align_t data[];
+};
+
+void arena_init(arena* a, size_t block_size) {
+    if (!a) return;
+    a->first = NULL;
+    a->current = NULL;
+    a->last = NULL;
+    a->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
 }
 
-void array_reverse(int* arr, size_t size) {
-    if (!arr || size <= 1) return;
-    
-    for (size_t i = 0; i < size / 2; i++) {
-        int temp = arr[i];
-        arr[i] = arr[size - 1 - i];
-        arr[size - 1 - i] = temp;
+void* arena_alloc(arena* a, size_t size) {
+    if (!a) return NULL;
+
+    // Every allocation is suitably aligned for any type
+    const size_t align = _Alignof(max_align_t);
+    if (size > SIZE_MAX - sizeof(arena_block) - align) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        exit(1);
+    }
+    size = size ? (size + align - 1) & ~(align - 1) : align;
+
+    // Blocks after the current one are only there after a reset, and empty
+    arena_block* block = a->current;
+    while (block && block->size - block->used < size) {
+        block = block->next;
     }
+    if (!block) {
+        size_t block_size = a->block_size ? a->block_size : ARENA_DEFAULT_BLOCK_SIZE;
+        if (block_size < size) block_size = size;
+        block = safe_malloc(sizeof(arena_block) + block_size);
+        block->next = NULL;
+        block->size = block_size;
+        block->used = 0;
+        if (a->last) {
+            a->last->next = block;
+        } else {
+            a->first = block;
+        }
+        a->last = block;
+    }
+    a->current = block;
+
+    void* ptr = (char*)block->data + block->used;
+    block->used += size;
+    return ptr;
 }
 
-int array_find(int* arr, size_t size, int value) {
-    if (!arr) return -1;
-    
-    for (size_t i = 0; i < size; i++) {
-        if (arr[i] == value) return (int)i;
+char* arena_strndup(arena* a, const char* str, size_t len) {
+    if (!a || (!str && len > 0)) return NULL;
+    char* copy = arena_alloc(a, len + 1);
+    if (len > 0) memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+void arena_reset(arena* a) {
+    if (!a) return;
+    for (arena_block* block = a->first; block; block = block->next) {
+        block->used = 0;
     }
-    return -1;
+    a->current = a->first;
 }
 
-void array_sort(int* arr, size_t size) {
-    if (!arr || size <= 1) return;
-    
-    // Simple bubble sort
-    for (size_t i = 0; i < size - 1; i++) {
-        for (size_t j = 0; j < size - i - 1; j++) {
-            if (arr[j] > arr[j + 1]) {
-                int temp = arr[j];
-                arr[j] = arr[j + 1];
-                arr[j + 1] = temp;
-            }
-        }
+void arena_free(arena* a) {
+    if (!a) return;
+    arena_block* block = a->first;
+    while (block) {
+        arena_block* next = block->next;
+        free(block);
+        block = next;
     }
+    a->first = NULL;
+    a->current = NULL;
+    a->last = NULL;
 }
 
+// Array utilities
 void array_print(int* arr, size_t size) {
     if (!arr) return;
     
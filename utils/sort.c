@@ -0,0 +1,329 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "utils.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Ranges this short are insertion-sorted
+#define SORT_INSERTION_THRESHOLD 24
+// Ranges this long use the ninther (median of three medians) as pivot
+#define SORT_NINTHER_THRESHOLD 128
+// From here on an LSD radix sort beats comparison sorting
+#define SORT_RADIX_THRESHOLD 2048
+// Below this, starting threads costs more than it saves
+#define SORT_PARALLEL_THRESHOLD 65536
+#define SORT_MAX_THREADS 64
+
+static inline void sort_swap(int* a, int* b) {
+    int t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void insertion_sort(int* arr, size_t size) {
+    for (size_t i = 1; i < size; i++) {
+        int value = arr[i];
+        size_t j = i;
+        while (j > 0 && arr[j - 1] > value) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = value;
+    }
+}
+
+static void sift_down(int* arr, size_t root, size_t size) {
+    int value = arr[root];
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= size) break;
+        if (child + 1 < size && arr[child + 1] > arr[child]) child++;
+        if (arr[child] <= value) break;
+        arr[root] = arr[child];
+        root = child;
+    }
+    arr[root] = value;
+}
+
+static void heap_sort(int* arr, size_t size) {
+    for (size_t i = size / 2; i-- > 0;) {
+        sift_down(arr, i, size);
+    }
+    for (size_t end = size; end-- > 1;) {
+        sort_swap(&arr[0], &arr[end]);
+        sift_down(arr, 0, end);
+    }
+}
+
+// Orders *a <= *b <= *c
+static inline void sort3(int* a, int* b, int* c) {
+    if (*b < *a) sort_swap(a, b);
+    if (*c < *b) sort_swap(b, c);
+    if (*b < *a) sort_swap(a, b);
+}
+
+// Introsort in the style of pdqsort: the pivot is moved to arr[0], and a
+// pivot equal to the element just left of the range (the previous pivot)
+// means the range holds many equal keys, which one pass then sets aside.
+// The depth limit falls back to heapsort, so the worst case is O(n log n).
+static void intro_sort(int* arr, size_t size, int depth, int leftmost) {
+    while (size > SORT_INSERTION_THRESHOLD) {
+        if (depth-- == 0) {
+            heap_sort(arr, size);
+            return;
+        }
+
+        size_t mid = size / 2;
+        if (size > SORT_NINTHER_THRESHOLD) {
+            sort3(&arr[0], &arr[mid], &arr[size - 1]);
+            sort3(&arr[1], &arr[mid - 1], &arr[size - 2]);
+            sort3(&arr[2], &arr[mid + 1], &arr[size - 3]);
+            sort3(&arr[mid - 1], &arr[mid], &arr[mid + 1]);
+        } else {
+            sort3(&arr[0], &arr[mid], &arr[size - 1]);
+        }
+        sort_swap(&arr[0], &arr[mid]);
+        int pivot = arr[0];
+
+        if (!leftmost && arr[-1] == pivot) {
+            // Everything equal to the pivot goes left and is done
+            size_t i = 0;
+            size_t j = size;
+            for (;;) {
+                while (pivot < arr[--j]) {
+                }
+                while (++i < j && !(pivot < arr[i])) {
+                }
+                if (i >= j) break;
+                sort_swap(&arr[i], &arr[j]);
+            }
+            arr += j + 1;
+            size -= j + 1;
+            continue;
+        }
+
+        // Hoare partition around arr[0]; arr[size - 1] >= pivot stops the
+        // first scan and arr[0] the second, so neither needs a bounds check
+        size_t i = 0;
+        size_t j = size;
+        for (;;) {
+            while (arr[++i] < pivot) {
+            }
+            while (pivot < arr[--j]) {
+            }
+            if (i >= j) break;
+            sort_swap(&arr[i], &arr[j]);
+        }
+        sort_swap(&arr[0], &arr[j]);
+
+        // Recurse into the smaller side and loop on the larger, bounding the
+        // stack at O(log n)
+        size_t left_size = j;
+        size_t right_size = size - j - 1;
+        if (left_size < right_size) {
+            intro_sort(arr, left_size, depth, leftmost);
+            arr += j + 1;
+            size = right_size;
+            leftmost = 0;
+        } else {
+            intro_sort(arr + j + 1, right_size, depth, 0);
+            size = left_size;
+        }
+    }
+    insertion_sort(arr, size);
+}
+
+static void comparison_sort(int* arr, size_t size) {
+    int depth = 0;
+    for (size_t n = size; n > 1; n >>= 1) depth += 2;
+    intro_sort(arr, size, depth, 1);
+}
+
+// LSD radix sort on bytes, the sign bit flipped so negative numbers order
+// first.  All four histograms come from one pass, and a byte that is the
+// same in every key costs no pass at all.  Returns 0 if tmp could not be
+// allocated.
+static int radix_sort(int* arr, size_t size) {
+    uint32_t* tmp = malloc(size * sizeof(uint32_t));
+    if (!tmp) return 0;
+
+    size_t counts[4][256];
+    memset(counts, 0, sizeof(counts));
+    const uint32_t* keys = (const uint32_t*)arr;
+    for (size_t i = 0; i < size; i++) {
+        uint32_t key = keys[i] ^ 0x80000000u;
+        counts[0][key & 0xff]++;
+        counts[1][(key >> 8) & 0xff]++;
+        counts[2][(key >> 16) & 0xff]++;
+        counts[3][key >> 24]++;
+    }
+
+    uint32_t* src = (uint32_t*)arr;
+    uint32_t* dst = tmp;
+    for (int pass = 0; pass < 4; pass++) {
+        int shift = pass * 8;
+        size_t* count = counts[pass];
+        if (count[(((src[0] ^ 0x80000000u) >> shift) & 0xff)] == size) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < size; i++) {
+            uint32_t value = src[i];
+            dst[count[((value ^ 0x80000000u) >> shift) & 0xff]++] = value;
+        }
+        uint32_t* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != (uint32_t*)arr) {
+        memcpy(arr, src, size * sizeof(uint32_t));
+    }
+    free(tmp);
+    return 1;
+}
+
+void array_sort(int* arr, size_t size) {
+    if (!arr || size <= 1) return;
+    if (size >= SORT_RADIX_THRESHOLD && radix_sort(arr, size)) return;
+    comparison_sort(arr, size);
+}
+
+// Merges the sorted runs src[0..mid) and src[mid..size) into dst
+static void merge_runs(const int* src, size_t mid, size_t size, int* dst) {
+    size_t i = 0, j = mid, k = 0;
+    while (i < mid && j < size) {
+        // Taking from the left on ties keeps the merge stable
+        int take_right = src[j] < src[i];
+        dst[k++] = take_right ? src[j] : src[i];
+        j += take_right;
+        i += !take_right;
+    }
+    memcpy(dst + k, src + i, (mid - i) * sizeof(int));
+    k += mid - i;
+    memcpy(dst + k, src + j, (size - j) * sizeof(int));
+}
+
+typedef struct {
+    int* src;
+    int* dst;
+    size_t begin;
+    size_t mid;
+    size_t end;
+} sort_task;
+
+static void* sort_chunk(void* arg) {
+    sort_task* task = arg;
+    array_sort(task->src + task->begin, task->end - task->begin);
+    return NULL;
+}
+
+static void* merge_chunk(void* arg) {
+    sort_task* task = arg;
+    merge_runs(task->src + task->begin, task->mid - task->begin, task->end - task->begin,
+               task->dst + task->begin);
+    return NULL;
+}
+
+// Runs every task, one thread each, the last on the calling thread
+static void run_tasks(sort_task* tasks, int count, void* (*work)(void*)) {
+    pthread_t threads[SORT_MAX_THREADS];
+    int started[SORT_MAX_THREADS];
+    for (int t = 0; t < count - 1; t++) {
+        started[t] = pthread_create(&threads[t], NULL, work, &tasks[t]) == 0;
+        if (!started[t]) work(&tasks[t]);
+    }
+    work(&tasks[count - 1]);
+    for (int t = 0; t < count - 1; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+void array_sort_parallel(int* arr, size_t size, int threads) {
+    if (!arr || size <= 1) return;
+    if (size < 2 * SORT_PARALLEL_THRESHOLD) {
+        array_sort(arr, size);
+        return;
+    }
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads > SORT_MAX_THREADS) threads = SORT_MAX_THREADS;
+    if ((size_t)threads > size / SORT_PARALLEL_THRESHOLD) threads = (int)(size / SORT_PARALLEL_THRESHOLD);
+    if (threads <= 1) {
+        array_sort(arr, size);
+        return;
+    }
+
+    int* tmp = malloc(size * sizeof(int));
+    if (!tmp) {
+        array_sort(arr, size);
+        return;
+    }
+
+    // Every thread sorts one chunk in place...
+    size_t bounds[SORT_MAX_THREADS + 1];
+    sort_task tasks[SORT_MAX_THREADS];
+    for (int t = 0; t <= threads; t++) {
+        bounds[t] = size * (size_t)t / (size_t)threads;
+    }
+    for (int t = 0; t < threads; t++) {
+        tasks[t] = (sort_task){ arr, NULL, bounds[t], bounds[t], bounds[t + 1] };
+    }
+    run_tasks(tasks, threads, sort_chunk);
+
+    // ...then neighbouring runs are merged pairwise, in parallel, until one
+    // run is left; the data moves between arr and tmp on every round
+    int runs = threads;
+    int* src = arr;
+    int* dst = tmp;
+    while (runs > 1) {
+        int merged = 0;
+        for (int r = 0; r < runs; r += 2) {
+            if (r + 1 < runs) {
+                tasks[merged] = (sort_task){ src, dst, bounds[r], bounds[r + 1], bounds[r + 2] };
+            } else {
+                // An odd run out is merged with nothing, i.e. copied
+                tasks[merged] = (sort_task){ src, dst, bounds[r], bounds[r + 1], bounds[r + 1] };
+            }
+            bounds[merged] = bounds[r];
+            merged++;
+        }
+        bounds[merged] = size;
+        run_tasks(tasks, merged, merge_chunk);
+        runs = merged;
+        int* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, size * sizeof(int));
+    }
+    free(tmp);
+}
+
+int array_bsearch(const int* arr, size_t size, int value) {
+    if (!arr || size == 0) return -1;
+
+    // Branch-free lower bound: halve the range each step with a conditional
+    // move instead of a hard-to-predict branch
+    const int* base = arr;
+    size_t n = size;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = base[half - 1] < value ? base + half : base;
+        n -= half;
+    }
+    if (*base < value) base++;
+    if (base == arr + size || *base != value) return -1;
+    return (int)(base - arr);
+}
@@ -14,13 +14,37 @@ void* safe_calloc(size_t num, size_t size);
 void* safe_realloc(void* ptr, size_t size);
 void safe_free(void* ptr);
 
+// Arena utilities: bump allocation from blocks obtained with safe_malloc,
+// released all at once.  Resetting keeps the blocks for reuse.  An arena is
+// not thread-safe; give each thread its own.
+typedef struct arena_block arena_block;
+typedef struct {
+    arena_block* first;
+    arena_block* current;
+    arena_block* last;
+    size_t block_size;
+} arena;
+
+void arena_init(arena* a, size_t block_size);
+void* arena_alloc(arena* a, size_t size);
+char* arena_strndup(arena* a, const char* str, size_t len);
+void arena_reset(arena* a);
+void arena_free(arena* a);
+
 // Array utilities
 void array_fill(int* arr, size_t size, int value);
 void array_reverse(int* arr, size_t size);
 int array_find(int* arr, size_t size, int value);
+long long array_sum(const int* arr, size_t size);
+int array_min_max(const int* arr, size_t size, int* min, int* max);
+size_t array_count_eq(const int* arr, size_t size, int value);
 void array_sort(int* arr, size_t size);
 void array_print(int* arr, size_t size);
 
+// Sorting: array_bsearch returns the first match in an ascending array, or -1
+void array_sort_parallel(int* arr, size_t size, int threads);
+int array_bsearch(const int* arr, size_t size, int value);
+
 // Time utilities
 void get_current_time(char* buffer, size_t buffer_size);
 void sleep_seconds(int seconds);